@@ -5,6 +5,7 @@
 #include "parserlib/parser.hpp"
 #include "parserlib/symbol_parse_node.hpp"
 #include "parserlib/string_parse_node.hpp"
+#include "parserlib/case_folding.hpp"
 #include "parserlib/bool_parse_node.hpp"
 #include "parserlib/loop_0_parse_node.hpp"
 #include "parserlib/loop_1_parse_node.hpp"
@@ -15,6 +16,10 @@
 #include "parserlib/sequence_parse_node.hpp"
 #include "parserlib/choice_parse_node.hpp"
 #include "parserlib/match_parse_node.hpp"
+#include "parserlib/grammar_analysis.hpp"
+#include "parserlib/grammar_optimizer.hpp"
+#include "parserlib/bytecode.hpp"
+#include "parserlib/static_parser.hpp"
 #include "parserlib/get_source.hpp"
 #include "parserlib/ast.hpp"
 #include "parserlib/util.hpp"
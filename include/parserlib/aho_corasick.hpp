@@ -0,0 +1,101 @@
+#ifndef PARSERLIB_AHO_CORASICK_HPP
+#define PARSERLIB_AHO_CORASICK_HPP
+
+
+#include <array>
+#include <vector>
+#include <algorithm>
+#include <cstdint>
+
+
+namespace parserlib {
+
+
+    class aho_corasick {
+    public:
+        static constexpr size_t npos = static_cast<size_t>(-1);
+
+        static constexpr size_t max_state_count = 4096;
+
+        bool build(const std::vector<std::vector<unsigned char>>& patterns, const std::array<unsigned char, 256>& keys) {
+            m_keys = keys;
+            m_transitions.assign(256, 0);
+            m_match_lengths.assign(1, 0);
+            m_max_length = 0;
+
+            for (const std::vector<unsigned char>& pattern : patterns) {
+                if (pattern.empty()) {
+                    return false;
+                }
+                size_t state = 0;
+                for (const unsigned char symbol : pattern) {
+                    const size_t transition = state * 256 + symbol;
+                    if (m_transitions[transition] == 0) {
+                        if (m_match_lengths.size() == max_state_count) {
+                            return false;
+                        }
+                        m_transitions[transition] = static_cast<std::uint32_t>(m_match_lengths.size());
+                        m_transitions.resize(m_transitions.size() + 256, 0);
+                        m_match_lengths.push_back(0);
+                    }
+                    state = m_transitions[transition];
+                }
+                m_match_lengths[state] = std::max(m_match_lengths[state], pattern.size());
+                m_max_length = std::max(m_max_length, pattern.size());
+            }
+
+            std::vector<std::uint32_t> failures(m_match_lengths.size(), 0);
+            std::vector<std::uint32_t> pending;
+            for (size_t symbol = 0; symbol < 256; ++symbol) {
+                if (m_transitions[symbol] != 0) {
+                    pending.push_back(m_transitions[symbol]);
+                }
+            }
+            for (size_t index = 0; index < pending.size(); ++index) {
+                const std::uint32_t state = pending[index];
+                m_match_lengths[state] = std::max(m_match_lengths[state], m_match_lengths[failures[state]]);
+                for (size_t symbol = 0; symbol < 256; ++symbol) {
+                    std::uint32_t& next = m_transitions[state * 256 + symbol];
+                    const std::uint32_t failure_next = m_transitions[failures[state] * 256 + symbol];
+                    if (next != 0) {
+                        failures[next] = failure_next;
+                        pending.push_back(next);
+                    }
+                    else {
+                        next = failure_next;
+                    }
+                }
+            }
+
+            return true;
+        }
+
+        template <class Iterator>
+        size_t find(Iterator it, Iterator end) const {
+            size_t state = 0;
+            size_t best_start = npos;
+            for (size_t index = 0; it != end; ++it, ++index) {
+                if (best_start != npos && index + 1 >= best_start + m_max_length) {
+                    break;
+                }
+                state = m_transitions[state * 256 + m_keys[static_cast<unsigned char>(*it)]];
+                const size_t length = m_match_lengths[state];
+                if (length > 0) {
+                    best_start = std::min(best_start, index + 1 - length);
+                }
+            }
+            return best_start;
+        }
+
+    private:
+        std::array<unsigned char, 256> m_keys{};
+        std::vector<std::uint32_t> m_transitions;
+        std::vector<size_t> m_match_lengths;
+        size_t m_max_length{ 0 };
+    };
+
+
+} //namespace parserlib
+
+
+#endif //PARSERLIB_AHO_CORASICK_HPP
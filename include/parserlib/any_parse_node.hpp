@@ -11,13 +11,21 @@ namespace parserlib {
     template <class ParseContext>
     class any_parse_node : public parse_node<ParseContext> {
     public:
-        bool parse(ParseContext& pc) const override {
+        parse_result parse(ParseContext& pc) const override {
             if (pc.is_valid_iterator()) {
                 pc.increment_iterator();
                 return true;
             }
             return false;
         }
+
+        bool analyze(grammar_analysis<ParseContext>& analysis) const override {
+            return analysis.analyze_any();
+        }
+
+        void compile(bytecode_compiler<ParseContext>& compiler) const override {
+            compiler.compile_any();
+        }
     };
 
 
@@ -0,0 +1,616 @@
+#ifndef PARSERLIB_BYTECODE_HPP
+#define PARSERLIB_BYTECODE_HPP
+
+
+#include <vector>
+#include <unordered_map>
+#include <algorithm>
+#include <type_traits>
+#include "grammar_analysis.hpp"
+#include "symbol_set.hpp"
+
+
+namespace parserlib {
+
+
+    enum class bytecode_opcode {
+        symbol,
+        string,
+        set,
+        range,
+        any,
+        end,
+        span_symbol,
+        span_set,
+        span_range,
+        span_any,
+        choice,
+        predicate_choice,
+        commit,
+        partial_commit,
+        back_commit,
+        fail_twice,
+        fail,
+        call,
+        ret,
+        open_match,
+        close_match,
+        open_error,
+        close_error,
+        increment_line,
+        parse_node,
+        succeed
+    };
+
+
+    template <class ParseContext>
+    class bytecode_compiler;
+
+
+    class bytecode_instruction {
+    public:
+        bytecode_instruction(bytecode_opcode opcode, size_t label = 0, size_t index = 0, int min = 0, int max = 0)
+            : m_opcode(opcode)
+            , m_min(min)
+            , m_max(max)
+            , m_label(label)
+            , m_index(index)
+        {
+        }
+
+        bytecode_opcode get_opcode() const {
+            return m_opcode;
+        }
+
+        size_t get_label() const {
+            return m_label;
+        }
+
+        size_t get_index() const {
+            return m_index;
+        }
+
+        int get_min() const {
+            return m_min;
+        }
+
+        int get_max() const {
+            return m_max;
+        }
+
+    private:
+        bytecode_opcode m_opcode;
+        int m_min;
+        int m_max;
+        size_t m_label;
+        size_t m_index;
+
+        template <class ParseContext>
+        friend class compiled_grammar;
+
+        template <class ParseContext>
+        friend class bytecode_compiler;
+    };
+
+
+    template <class ParseContext>
+    class compiled_grammar {
+    public:
+        using parse_node_type = parse_node<ParseContext>;
+        using match_id_type = typename ParseContext::match_id_type;
+        using error_id_type = typename ParseContext::error_id_type;
+
+        const std::vector<bytecode_instruction>& get_instructions() const {
+            return m_instructions;
+        }
+
+        parse_result parse(ParseContext& pc) const {
+            using parse_checkpoint_type = typename ParseContext::parse_checkpoint_type;
+            using parse_state_type = typename ParseContext::parse_state_type;
+
+            struct backtrack_entry {
+                parse_checkpoint_type m_checkpoint;
+                size_t m_ip;
+                size_t m_call_count;
+                size_t m_capture_count;
+                size_t m_cut_scope;
+            };
+
+            std::vector<backtrack_entry> backtracks;
+            std::vector<size_t> calls;
+            std::vector<parse_state_type> captures;
+            const size_t partition = pc.get_open_partition_count();
+
+            backtracks.push_back(backtrack_entry{ pc.get_checkpoint(), npos, 0, 0, npos });
+
+            size_t ip = 0;
+
+            for (;;) {
+                const bytecode_instruction& instruction = m_instructions[ip];
+
+                switch (instruction.m_opcode) {
+                    case bytecode_opcode::symbol:
+                        if (pc.is_valid_iterator() && pc.compare(*pc.get_iterator(), instruction.m_min) == 0) {
+                            pc.increment_iterator();
+                            ++ip;
+                            continue;
+                        }
+                        break;
+
+                    case bytecode_opcode::string:
+                        if (parse_string(pc, m_strings[instruction.m_index])) {
+                            ++ip;
+                            continue;
+                        }
+                        break;
+
+                    case bytecode_opcode::set:
+                        if (pc.is_valid_iterator() && m_sets[instruction.m_index].contains(*pc.get_iterator())) {
+                            pc.increment_iterator();
+                            ++ip;
+                            continue;
+                        }
+                        break;
+
+                    case bytecode_opcode::range:
+                        if (pc.is_valid_iterator() && is_in_range(pc, *pc.get_iterator(), instruction)) {
+                            pc.increment_iterator();
+                            ++ip;
+                            continue;
+                        }
+                        break;
+
+                    case bytecode_opcode::any:
+                        if (pc.is_valid_iterator()) {
+                            pc.increment_iterator();
+                            ++ip;
+                            continue;
+                        }
+                        break;
+
+                    case bytecode_opcode::end:
+                        if (!pc.is_valid_iterator()) {
+                            ++ip;
+                            continue;
+                        }
+                        break;
+
+                    case bytecode_opcode::span_symbol:
+                        while (pc.is_valid_iterator() && pc.compare(*pc.get_iterator(), instruction.m_min) == 0) {
+                            pc.increment_iterator();
+                        }
+                        ++ip;
+                        continue;
+
+                    case bytecode_opcode::span_set:
+                        while (pc.is_valid_iterator() && m_sets[instruction.m_index].contains(*pc.get_iterator())) {
+                            pc.increment_iterator();
+                        }
+                        ++ip;
+                        continue;
+
+                    case bytecode_opcode::span_range:
+                        while (pc.is_valid_iterator() && is_in_range(pc, *pc.get_iterator(), instruction)) {
+                            pc.increment_iterator();
+                        }
+                        ++ip;
+                        continue;
+
+                    case bytecode_opcode::span_any:
+                        while (pc.is_valid_iterator()) {
+                            pc.increment_iterator();
+                        }
+                        ++ip;
+                        continue;
+
+                    case bytecode_opcode::choice:
+                        backtracks.push_back(backtrack_entry{ pc.get_checkpoint(), instruction.m_label, calls.size(), captures.size(), npos });
+                        ++ip;
+                        continue;
+
+                    case bytecode_opcode::predicate_choice:
+                        backtracks.push_back(backtrack_entry{ pc.get_checkpoint(), instruction.m_label, calls.size(), captures.size(), pc.begin_cut_scope() });
+                        ++ip;
+                        continue;
+
+                    case bytecode_opcode::commit:
+                        backtracks.pop_back();
+                        ip = instruction.m_label;
+                        continue;
+
+                    case bytecode_opcode::partial_commit:
+                        if (pc.get_iterator() == backtracks.back().m_checkpoint.get_iterator()) {
+                            pc.restore_checkpoint(backtracks.back().m_checkpoint);
+                            backtracks.pop_back();
+                            ip = instruction.m_index;
+                        }
+                        else {
+                            backtracks.back().m_checkpoint = pc.get_checkpoint();
+                            ip = instruction.m_label;
+                        }
+                        continue;
+
+                    case bytecode_opcode::back_commit:
+                        restore_backtrack_entry(pc, backtracks.back());
+                        backtracks.pop_back();
+                        ip = instruction.m_label;
+                        continue;
+
+                    case bytecode_opcode::fail_twice:
+                        end_cut_scope(pc, backtracks.back());
+                        backtracks.pop_back();
+                        break;
+
+                    case bytecode_opcode::fail:
+                        break;
+
+                    case bytecode_opcode::call:
+                        if (pc.is_memoization_enabled()) {
+                            const parse_result result = m_parse_nodes[instruction.m_index]->parse(pc);
+                            if (result) {
+                                ++ip;
+                                continue;
+                            }
+                            if (result.is_left_recursion()) {
+                                restore_first_backtrack_entry(pc, backtracks);
+                                pc.close_partition(partition);
+                                return result;
+                            }
+                            break;
+                        }
+                        calls.push_back(ip + 1);
+                        ip = instruction.m_label;
+                        continue;
+
+                    case bytecode_opcode::ret:
+                        ip = calls.back();
+                        calls.pop_back();
+                        continue;
+
+                    case bytecode_opcode::open_match:
+                        captures.push_back(pc.get_match_parse_state());
+                        pc.open_partition(captures.back().get_iterator());
+                        ++ip;
+                        continue;
+
+                    case bytecode_opcode::close_match:
+                        pc.add_match(m_match_ids[instruction.m_index], captures.back());
+                        captures.pop_back();
+                        pc.close_partition(partition + captures.size());
+                        ++ip;
+                        continue;
+
+                    case bytecode_opcode::open_error:
+                        captures.push_back(parse_state_type(pc.get_iterator()));
+                        pc.open_partition(captures.back().get_iterator());
+                        ++ip;
+                        continue;
+
+                    case bytecode_opcode::close_error:
+                        pc.add_error(m_error_ids[instruction.m_index], captures.back().get_iterator());
+                        captures.pop_back();
+                        pc.close_partition(partition + captures.size());
+                        ++ip;
+                        continue;
+
+                    case bytecode_opcode::increment_line:
+                        pc.increment_line();
+                        ++ip;
+                        continue;
+
+                    case bytecode_opcode::parse_node: {
+                        const parse_result result = m_parse_nodes[instruction.m_index]->parse(pc);
+                        if (result) {
+                            ++ip;
+                            continue;
+                        }
+                        if (result.is_left_recursion()) {
+                            restore_first_backtrack_entry(pc, backtracks);
+                            pc.close_partition(partition);
+                            return result;
+                        }
+                        break;
+                    }
+
+                    case bytecode_opcode::succeed:
+                        return true;
+                }
+
+                backtrack_entry entry = backtracks.back();
+                backtracks.pop_back();
+                while (!restore_backtrack_entry(pc, entry) && entry.m_ip != npos) {
+                    entry = backtracks.back();
+                    backtracks.pop_back();
+                }
+                if (entry.m_ip == npos) {
+                    pc.close_partition(partition);
+                    return false;
+                }
+                calls.resize(entry.m_call_count);
+                captures.erase(captures.begin() + entry.m_capture_count, captures.end());
+                pc.close_partition(partition + entry.m_capture_count);
+                ip = entry.m_ip;
+            }
+        }
+
+    private:
+        static constexpr size_t npos = static_cast<size_t>(-1);
+
+        parse_node_ptr<ParseContext> m_grammar;
+        std::vector<bytecode_instruction> m_instructions;
+        std::vector<std::vector<int>> m_strings;
+        std::vector<symbol_set<ParseContext, int>> m_sets;
+        std::vector<match_id_type> m_match_ids;
+        std::vector<error_id_type> m_error_ids;
+        std::vector<const parse_node_type*> m_parse_nodes;
+
+        template <class BacktrackEntry>
+        static void end_cut_scope(ParseContext& pc, const BacktrackEntry& entry) {
+            if (entry.m_cut_scope != npos) {
+                pc.end_cut_scope(entry.m_cut_scope);
+            }
+        }
+
+        template <class BacktrackEntry>
+        static bool restore_backtrack_entry(ParseContext& pc, const BacktrackEntry& entry) {
+            end_cut_scope(pc, entry);
+            return pc.restore_checkpoint(entry.m_checkpoint);
+        }
+
+        template <class BacktrackEntries>
+        static void restore_first_backtrack_entry(ParseContext& pc, const BacktrackEntries& entries) {
+            for (auto it = entries.rbegin(); it != entries.rend(); ++it) {
+                end_cut_scope(pc, *it);
+            }
+            pc.restore_checkpoint(entries.front().m_checkpoint);
+        }
+
+        static bool parse_string(ParseContext& pc, const std::vector<int>& string) {
+            auto itSrc = pc.get_iterator();
+            for (const int symbol : string) {
+                if (itSrc == pc.get_end_iterator() || pc.compare(*itSrc, symbol) != 0) {
+                    return false;
+                }
+                ++itSrc;
+            }
+            pc.increment_iterator(string.size());
+            return true;
+        }
+
+        template <class Token>
+        static bool is_in_range(ParseContext& pc, const Token& token, const bytecode_instruction& instruction) {
+            return pc.compare(token, instruction.m_min) >= 0 && pc.compare(token, instruction.m_max) <= 0;
+        }
+
+        friend class bytecode_compiler<ParseContext>;
+    };
+
+
+    template <class ParseContext>
+    class bytecode_compiler {
+    public:
+        using parse_node_type = parse_node<ParseContext>;
+        using rule_parse_node_type = rule_parse_node<ParseContext>;
+        using match_id_type = typename ParseContext::match_id_type;
+        using error_id_type = typename ParseContext::error_id_type;
+
+        bytecode_compiler(const parse_node_ptr<ParseContext>& grammar)
+            : m_analysis(grammar)
+        {
+            m_program.m_grammar = grammar;
+            compile(grammar.get());
+            emit(bytecode_opcode::succeed);
+
+            for (size_t index = 0; index < m_rules.size(); ++index) {
+                m_rule_labels[m_rules[index]] = m_program.m_instructions.size();
+                compile(m_rules[index]->get_parse_node().get());
+                emit(bytecode_opcode::ret);
+            }
+
+            for (const auto& [instruction_index, rule] : m_calls) {
+                m_program.m_instructions[instruction_index].m_label = m_rule_labels[rule];
+            }
+        }
+
+        const compiled_grammar<ParseContext>& get_compiled_grammar() const {
+            return m_program;
+        }
+
+        void compile(const parse_node_type* parse_node) {
+            parse_node->compile(*this);
+        }
+
+        void compile_parse_node(const parse_node_type* parse_node) {
+            emit(bytecode_opcode::parse_node, 0, add_parse_node(parse_node));
+        }
+
+        void compile_symbol(int symbol) {
+            emit(bytecode_opcode::symbol, 0, 0, symbol);
+        }
+
+        void compile_string(const std::vector<int>& string) {
+            m_program.m_strings.push_back(string);
+            emit(bytecode_opcode::string, 0, m_program.m_strings.size() - 1);
+        }
+
+        void compile_set(const std::vector<int>& set) {
+            m_program.m_sets.emplace_back(set.begin(), set.end());
+            emit(bytecode_opcode::set, 0, m_program.m_sets.size() - 1);
+        }
+
+        void compile_range(int min, int max) {
+            emit(bytecode_opcode::range, 0, 0, min, max);
+        }
+
+        void compile_any() {
+            emit(bytecode_opcode::any);
+        }
+
+        void compile_end() {
+            emit(bytecode_opcode::end);
+        }
+
+        void compile_true() {
+        }
+
+        void compile_false() {
+            emit(bytecode_opcode::fail);
+        }
+
+        void compile_sequence(const std::vector<parse_node_ptr<ParseContext>>& parse_nodes) {
+            for (const parse_node_ptr<ParseContext>& parse_node : parse_nodes) {
+                compile(parse_node.get());
+            }
+        }
+
+        void compile_choice(const std::vector<parse_node_ptr<ParseContext>>& parse_nodes) {
+            std::vector<size_t> commits;
+            for (size_t index = 0; index + 1 < parse_nodes.size(); ++index) {
+                const size_t choice = emit(bytecode_opcode::choice);
+                compile(parse_nodes[index].get());
+                commits.push_back(emit(bytecode_opcode::commit));
+                set_label(choice);
+            }
+            compile(parse_nodes.back().get());
+            for (const size_t commit : commits) {
+                set_label(commit);
+            }
+        }
+
+        void compile_loop_0(const parse_node_type* parse_node) {
+            const size_t choice = emit(bytecode_opcode::choice);
+            compile(parse_node);
+            if (m_program.m_instructions.size() == choice + 2 && make_span(m_program.m_instructions[choice + 1])) {
+                m_program.m_instructions[choice] = m_program.m_instructions[choice + 1];
+                m_program.m_instructions.pop_back();
+                return;
+            }
+            const size_t partial_commit = emit(bytecode_opcode::partial_commit, choice + 1);
+            set_label(choice);
+            m_program.m_instructions[partial_commit].m_index = m_program.m_instructions.size();
+        }
+
+        void compile_loop_1(const parse_node_type* parse_node) {
+            compile(parse_node);
+            compile_loop_0(parse_node);
+        }
+
+        void compile_loop_n(const parse_node_type* parse_node, size_t times) {
+            for (size_t count = 0; count < times; ++count) {
+                compile(parse_node);
+            }
+        }
+
+        void compile_optional(const parse_node_type* parse_node) {
+            const size_t choice = emit(bytecode_opcode::choice);
+            compile(parse_node);
+            const size_t commit = emit(bytecode_opcode::commit);
+            set_label(choice);
+            set_label(commit);
+        }
+
+        void compile_logical_and(const parse_node_type* parse_node) {
+            const size_t choice = emit(bytecode_opcode::predicate_choice);
+            compile(parse_node);
+            const size_t back_commit = emit(bytecode_opcode::back_commit);
+            set_label(choice);
+            emit(bytecode_opcode::fail);
+            set_label(back_commit);
+        }
+
+        void compile_logical_not(const parse_node_type* parse_node) {
+            const size_t choice = emit(bytecode_opcode::predicate_choice);
+            compile(parse_node);
+            emit(bytecode_opcode::fail_twice);
+            set_label(choice);
+        }
+
+        void compile_match(const parse_node_type* parse_node, const match_id_type& id) {
+            emit(bytecode_opcode::open_match);
+            compile(parse_node);
+            m_program.m_match_ids.push_back(id);
+            emit(bytecode_opcode::close_match, 0, m_program.m_match_ids.size() - 1);
+        }
+
+        void compile_error(const parse_node_type* parse_node, const error_id_type& id) {
+            emit(bytecode_opcode::open_error);
+            compile(parse_node);
+            m_program.m_error_ids.push_back(id);
+            emit(bytecode_opcode::close_error, 0, m_program.m_error_ids.size() - 1);
+        }
+
+        void compile_newline(const parse_node_type* parse_node) {
+            compile(parse_node);
+            emit(bytecode_opcode::increment_line);
+        }
+
+        void compile_rule(const rule_parse_node_type* rule) {
+            if (!rule->get_parse_node() || rule->is_memoized() || m_analysis.is_left_recursive(rule)) {
+                compile_parse_node(rule);
+                return;
+            }
+            if (m_rule_labels.find(rule) == m_rule_labels.end()) {
+                m_rule_labels[rule] = 0;
+                m_rules.push_back(rule);
+            }
+            m_calls.push_back(std::make_pair(emit(bytecode_opcode::call, 0, add_parse_node(rule)), rule));
+        }
+
+    private:
+        grammar_analysis<ParseContext> m_analysis;
+        compiled_grammar<ParseContext> m_program;
+        std::vector<const rule_parse_node_type*> m_rules;
+        std::unordered_map<const rule_parse_node_type*, size_t> m_rule_labels;
+        std::vector<std::pair<size_t, const rule_parse_node_type*>> m_calls;
+
+        size_t emit(bytecode_opcode opcode, size_t label = 0, size_t index = 0, int min = 0, int max = 0) {
+            m_program.m_instructions.push_back(bytecode_instruction(opcode, label, index, min, max));
+            return m_program.m_instructions.size() - 1;
+        }
+
+        void set_label(size_t instruction_index) {
+            m_program.m_instructions[instruction_index].m_label = m_program.m_instructions.size();
+        }
+
+        size_t add_parse_node(const parse_node_type* parse_node) {
+            m_program.m_parse_nodes.push_back(parse_node);
+            return m_program.m_parse_nodes.size() - 1;
+        }
+
+        static bool make_span(bytecode_instruction& instruction) {
+            switch (instruction.m_opcode) {
+                case bytecode_opcode::symbol:
+                    instruction.m_opcode = bytecode_opcode::span_symbol;
+                    return true;
+                case bytecode_opcode::set:
+                    instruction.m_opcode = bytecode_opcode::span_set;
+                    return true;
+                case bytecode_opcode::range:
+                    instruction.m_opcode = bytecode_opcode::span_range;
+                    return true;
+                case bytecode_opcode::any:
+                    instruction.m_opcode = bytecode_opcode::span_any;
+                    return true;
+                default:
+                    return false;
+            }
+        }
+    };
+
+
+    template <class ParseContext>
+    compiled_grammar<ParseContext> compile(const parse_node_ptr<ParseContext>& grammar) {
+        return bytecode_compiler<ParseContext>(grammar).get_compiled_grammar();
+    }
+
+
+    template <class ParseContext>
+    compiled_grammar<ParseContext> compile(const rule<ParseContext>& grammar) {
+        return compile(grammar.m_parse_node);
+    }
+
+
+} //namespace parserlib
+
+
+#endif //PARSERLIB_BYTECODE_HPP
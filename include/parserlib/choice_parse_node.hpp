@@ -3,6 +3,12 @@
 
 
 #include <vector>
+#include <map>
+#include <limits>
+#include <iterator>
+#include <cstdint>
+#include <type_traits>
+#include "parse_context.hpp"
 #include "rule.hpp"
 
 
@@ -21,29 +27,137 @@ namespace parserlib {
             return m_parse_nodes;
         }
 
-        bool parse(ParseContext& pc) const override {
-            const typename ParseContext::parse_context_state_type base_state = pc.get_state();
+        parse_result parse(ParseContext& pc) const override {
+            if (!m_dispatch_table.empty() && pc.is_valid_iterator()) {
+                const size_t key = static_cast<size_t>(static_cast<int>(*pc.get_iterator()) - m_dispatch_min_symbol);
+                return parse_alternatives(pc, m_dispatch_lists[key < m_dispatch_table.size() ? m_dispatch_table[key] : 0]);
+            }
+            return parse_alternatives(pc, m_parse_nodes);
+        }
 
+        bool analyze(grammar_analysis<ParseContext>& analysis) const override {
+            bool nullable = false;
             for (const parse_node_ptr<ParseContext>& parse_node : m_parse_nodes) {
-                try {
-                    const bool result = parse_node->parse(pc);
-                    if (result) {
-                        return true;
+                if (analysis.analyze(parse_node.get())) {
+                    nullable = true;
+                }
+            }
+            return nullable;
+        }
+
+        void freeze(const grammar_analysis<ParseContext>& analysis) override {
+            m_dispatch_table.clear();
+            m_dispatch_lists.clear();
+
+            using symbol_type = typename std::iterator_traits<typename ParseContext::iterator_type>::value_type;
+
+            int min_symbol = std::numeric_limits<int>::max();
+            int max_symbol = std::numeric_limits<int>::min();
+
+            if constexpr (std::is_integral_v<symbol_type> && sizeof(symbol_type) == 1) {
+                min_symbol = std::numeric_limits<symbol_type>::min();
+                max_symbol = std::numeric_limits<symbol_type>::max();
+            }
+            else if constexpr (std::is_same_v<typename ParseContext::symbol_comparator_type, default_symbol_comparator>) {
+                for (const parse_node_ptr<ParseContext>& parse_node : m_parse_nodes) {
+                    for (const auto& [min, max] : analysis.get_first_set(parse_node.get()).get_ranges()) {
+                        min_symbol = std::min(min_symbol, min);
+                        max_symbol = std::max(max_symbol, max);
                     }
                 }
-                catch (...) {
-                    pc.set_state(base_state);
-                    throw;
+                if (min_symbol > max_symbol || static_cast<long long>(max_symbol) - min_symbol >= max_dispatch_table_size) {
+                    return;
                 }
+            }
+            else {
+                return;
+            }
 
-                pc.set_state(base_state);
+            std::vector<parse_node_type*> default_list;
+            for (const parse_node_ptr<ParseContext>& parse_node : m_parse_nodes) {
+                if (analysis.is_nullable(parse_node.get()) || analysis.get_first_set(parse_node.get()).is_any()) {
+                    default_list.push_back(parse_node.get());
+                }
             }
 
-            return false;
+            std::vector<std::vector<parse_node_type*>> dispatch_lists{ default_list };
+            std::map<std::vector<parse_node_type*>, size_t> dispatch_list_indexes{ { default_list, 0 } };
+            std::vector<std::uint16_t> dispatch_table;
+            bool selective = false;
+
+            for (long long symbol = min_symbol; symbol <= max_symbol; ++symbol) {
+                std::vector<parse_node_type*> list;
+                for (const parse_node_ptr<ParseContext>& parse_node : m_parse_nodes) {
+                    if (analysis.is_nullable(parse_node.get()) || analysis.get_first_set(parse_node.get()).template contains<ParseContext>(static_cast<int>(symbol))) {
+                        list.push_back(parse_node.get());
+                    }
+                }
+                if (list.size() < m_parse_nodes.size()) {
+                    selective = true;
+                }
+                auto it = dispatch_list_indexes.find(list);
+                if (it == dispatch_list_indexes.end()) {
+                    it = dispatch_list_indexes.emplace(list, dispatch_lists.size()).first;
+                    dispatch_lists.push_back(list);
+                }
+                dispatch_table.push_back(static_cast<std::uint16_t>(it->second));
+            }
+
+            if (selective) {
+                m_dispatch_min_symbol = min_symbol;
+                m_dispatch_table = std::move(dispatch_table);
+                m_dispatch_lists = std::move(dispatch_lists);
+            }
+        }
+
+        bool is_dispatched() const {
+            return !m_dispatch_table.empty();
+        }
+
+        void compile(bytecode_compiler<ParseContext>& compiler) const override {
+            compiler.compile_choice(m_parse_nodes);
+        }
+
+        parse_node_ptr<ParseContext> optimize(grammar_optimizer<ParseContext>& optimizer) override {
+            m_dispatch_table.clear();
+            m_dispatch_lists.clear();
+            for (parse_node_ptr<ParseContext>& parse_node : m_parse_nodes) {
+                parse_node = optimizer.optimize(parse_node);
+            }
+            return optimizer.optimize_choice(m_parse_nodes);
         }
 
     private:
+        using parse_node_type = parse_node<ParseContext>;
+
+        static constexpr long long max_dispatch_table_size = 1024;
+
         std::vector<parse_node_ptr<ParseContext>> m_parse_nodes;
+        std::vector<std::uint16_t> m_dispatch_table;
+        std::vector<std::vector<parse_node_type*>> m_dispatch_lists;
+        int m_dispatch_min_symbol{ 0 };
+
+        template <class ParseNodes>
+        static parse_result parse_alternatives(ParseContext& pc, const ParseNodes& parse_nodes) {
+            if (parse_nodes.empty()) {
+                return false;
+            }
+
+            const typename ParseContext::parse_checkpoint_type base_checkpoint = pc.get_checkpoint();
+
+            for (const auto& parse_node : parse_nodes) {
+                const parse_result result = parse_node->parse(pc);
+                if (result) {
+                    return true;
+                }
+
+                if (!pc.restore_checkpoint(base_checkpoint) || result.is_left_recursion()) {
+                    return result;
+                }
+            }
+
+            return false;
+        }
     };
 
 
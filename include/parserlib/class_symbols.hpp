@@ -0,0 +1,60 @@
+#ifndef PARSERLIB_CLASS_SYMBOLS_HPP
+#define PARSERLIB_CLASS_SYMBOLS_HPP
+
+
+#include <bitset>
+#include <algorithm>
+#include <iterator>
+#include <type_traits>
+#include "symbol_parse_node.hpp"
+#include "set_parse_node.hpp"
+#include "range_parse_node.hpp"
+#include "choice_parse_node.hpp"
+
+
+namespace parserlib {
+
+
+    template <class ParseContext>
+    bool get_class_symbols(const parse_node_ptr<ParseContext>& parse_node, std::bitset<256>& symbols) {
+        using token_type = typename std::iterator_traits<typename ParseContext::iterator_type>::value_type;
+        if constexpr (std::is_integral_v<token_type> && sizeof(token_type) == 1) {
+            using symbol_type = token_type;
+            if (const auto* choice = dynamic_cast<const choice_parse_node<ParseContext>*>(parse_node.get())) {
+                for (const parse_node_ptr<ParseContext>& alternative : choice->get_parse_nodes()) {
+                    if (!get_class_symbols(alternative, symbols)) {
+                        return false;
+                    }
+                }
+                return true;
+            }
+            const auto* symbol = dynamic_cast<const symbol_parse_node<ParseContext, symbol_type>*>(parse_node.get());
+            const auto* set = dynamic_cast<const set_parse_node<ParseContext, symbol_type>*>(parse_node.get());
+            const auto* range = dynamic_cast<const range_parse_node<ParseContext, symbol_type>*>(parse_node.get());
+            if (!symbol && !set && !range) {
+                return false;
+            }
+            for (size_t index = 0; index < symbols.size(); ++index) {
+                const token_type token = static_cast<token_type>(index);
+                if (symbol) {
+                    symbols[index] = symbols[index] || ParseContext::compare(token, symbol->get_symbol()) == 0;
+                }
+                else if (set) {
+                    symbols[index] = symbols[index] || std::any_of(set->get_set().begin(), set->get_set().end(), [&](const symbol_type& s) { return ParseContext::compare(token, s) == 0; });
+                }
+                else {
+                    symbols[index] = symbols[index] || (ParseContext::compare(token, range->get_min()) >= 0 && ParseContext::compare(token, range->get_max()) <= 0);
+                }
+            }
+            return true;
+        }
+        else {
+            return false;
+        }
+    }
+
+
+} //namespace parserlib
+
+
+#endif //PARSERLIB_CLASS_SYMBOLS_HPP
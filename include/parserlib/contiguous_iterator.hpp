@@ -0,0 +1,106 @@
+#ifndef PARSERLIB_CONTIGUOUS_ITERATOR_HPP
+#define PARSERLIB_CONTIGUOUS_ITERATOR_HPP
+
+
+#include <string>
+#include <string_view>
+#include <vector>
+#include <memory>
+#include <iterator>
+#include <type_traits>
+#include <algorithm>
+#include <cstddef>
+#include "text_iterator.hpp"
+
+
+namespace parserlib {
+
+
+    template <class Iterator, class = void>
+    struct is_contiguous_iterator_base : std::false_type {
+    };
+
+
+    template <class T>
+    struct is_contiguous_iterator_base<T*, void> : std::true_type {
+    };
+
+
+    template <class Iterator>
+    struct is_contiguous_iterator_base<Iterator, std::enable_if_t<std::is_integral_v<typename Iterator::value_type>>> : std::bool_constant<
+        std::is_same_v<Iterator, typename std::basic_string<typename Iterator::value_type>::iterator> ||
+        std::is_same_v<Iterator, typename std::basic_string<typename Iterator::value_type>::const_iterator> ||
+        std::is_same_v<Iterator, typename std::basic_string_view<typename Iterator::value_type>::const_iterator> ||
+        std::is_same_v<Iterator, typename std::vector<typename Iterator::value_type>::iterator> ||
+        std::is_same_v<Iterator, typename std::vector<typename Iterator::value_type>::const_iterator>>
+    {
+    };
+
+
+    template <class Iterator>
+    struct is_contiguous_iterator : is_contiguous_iterator_base<Iterator> {
+    };
+
+
+    template <class Iterator>
+    struct is_contiguous_iterator<text_iterator<Iterator>> : is_contiguous_iterator<Iterator> {
+    };
+
+
+    template <class Iterator>
+    inline constexpr bool is_contiguous_iterator_v = is_contiguous_iterator<Iterator>::value;
+
+
+    template <class Iterator>
+    auto get_iterator_address(const Iterator& it) {
+        return std::addressof(*it);
+    }
+
+
+    template <class Iterator>
+    struct is_segmented_iterator : std::false_type {
+    };
+
+
+    template <class Iterator>
+    struct is_segmented_iterator<text_iterator<Iterator>> : is_segmented_iterator<Iterator> {
+    };
+
+
+    template <class Iterator>
+    inline constexpr bool is_segmented_iterator_v = is_segmented_iterator<Iterator>::value;
+
+
+    inline constexpr size_t padding_size = 64;
+
+
+    template <class Iterator>
+    struct is_padded_iterator : std::false_type {
+    };
+
+
+    template <class Iterator>
+    struct is_padded_iterator<text_iterator<Iterator>> : is_padded_iterator<Iterator> {
+    };
+
+
+    template <class Iterator>
+    inline constexpr bool is_padded_iterator_v = is_padded_iterator<Iterator>::value;
+
+
+    template <class Iterator>
+    size_t get_segment_size(const Iterator& it, const Iterator& end) {
+        const size_t size = static_cast<size_t>(end - it);
+        if constexpr (is_segmented_iterator_v<Iterator>) {
+            return size > 0 ? std::min(it.get_segment_size(), size) : 0;
+        }
+        else {
+            return size;
+        }
+    }
+
+
+} //namespace parserlib
+
+
+#endif //PARSERLIB_CONTIGUOUS_ITERATOR_HPP
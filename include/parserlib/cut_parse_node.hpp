@@ -0,0 +1,28 @@
+#ifndef PARSERLIB_CUT_PARSE_NODE_HPP
+#define PARSERLIB_CUT_PARSE_NODE_HPP
+
+
+#include "parse_node.hpp"
+
+
+namespace parserlib {
+
+
+    template <class ParseContext>
+    class cut_parse_node : public parse_node<ParseContext> {
+    public:
+        parse_result parse(ParseContext& pc) const override {
+            pc.cut();
+            return true;
+        }
+
+        bool analyze(grammar_analysis<ParseContext>& analysis) const override {
+            return analysis.analyze_cut();
+        }
+    };
+
+
+} //namespace parserlib
+
+
+#endif //PARSERLIB_CUT_PARSE_NODE_HPP
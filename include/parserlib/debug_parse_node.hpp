@@ -16,11 +16,20 @@ namespace parserlib {
         {
         }
 
-        bool parse(ParseContext& pc) const override {
-            const bool result = m_parse_node->parse(pc);
+        parse_result parse(ParseContext& pc) const override {
+            const parse_result result = m_parse_node->parse(pc);
             return result;
         }
 
+        bool analyze(grammar_analysis<ParseContext>& analysis) const override {
+            return analysis.analyze(m_parse_node.get());
+        }
+
+        parse_node_ptr<ParseContext> optimize(grammar_optimizer<ParseContext>& optimizer) override {
+            m_parse_node = optimizer.optimize(m_parse_node);
+            return {};
+        }
+
     private:
         parse_node_ptr<ParseContext> m_parse_node;
     };
@@ -11,9 +11,17 @@ namespace parserlib {
     template <class ParseContext>
     class end_parse_node : public parse_node<ParseContext> {
     public:
-        bool parse(ParseContext& pc) const override {
+        parse_result parse(ParseContext& pc) const override {
             return !pc.is_valid_iterator();
         }
+
+        bool analyze(grammar_analysis<ParseContext>&) const override {
+            return true;
+        }
+
+        void compile(bytecode_compiler<ParseContext>& compiler) const override {
+            compiler.compile_end();
+        }
     };
 
 
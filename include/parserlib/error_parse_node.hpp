@@ -19,13 +19,28 @@ namespace parserlib {
         {
         }
 
-        bool parse(ParseContext& pc) const override {
+        parse_result parse(ParseContext& pc) const override {
             const auto from_iterator = pc.get_iterator();
-            if (m_parse_node->parse(pc)) {
+            const size_t partition = pc.open_partition(from_iterator);
+            const parse_result result = m_parse_node->parse(pc);
+            pc.close_partition(partition);
+            if (result) {
                 pc.add_error(m_id, from_iterator);
-                return true;
             }
-            return false;
+            return result;
+        }
+
+        bool analyze(grammar_analysis<ParseContext>& analysis) const override {
+            return analysis.analyze(m_parse_node.get());
+        }
+
+        void compile(bytecode_compiler<ParseContext>& compiler) const override {
+            compiler.compile_error(m_parse_node.get(), m_id);
+        }
+
+        parse_node_ptr<ParseContext> optimize(grammar_optimizer<ParseContext>& optimizer) override {
+            m_parse_node = optimizer.optimize(m_parse_node);
+            return {};
         }
 
     private:
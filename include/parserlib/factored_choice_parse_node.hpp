@@ -0,0 +1,107 @@
+#ifndef PARSERLIB_FACTORED_CHOICE_PARSE_NODE_HPP
+#define PARSERLIB_FACTORED_CHOICE_PARSE_NODE_HPP
+
+
+#include <vector>
+#include <optional>
+#include "parse_node_ptr.hpp"
+
+
+namespace parserlib {
+
+
+    template <class ParseContext>
+    class factored_choice_parse_node : public parse_node<ParseContext> {
+    public:
+        using id_type = typename ParseContext::match_id_type;
+
+        factored_choice_parse_node(const parse_node_ptr<ParseContext>& prefix, const std::vector<parse_node_ptr<ParseContext>>& parse_nodes, const std::vector<std::optional<id_type>>& ids)
+            : m_prefix(prefix)
+            , m_parse_nodes(parse_nodes)
+            , m_ids(ids)
+        {
+        }
+
+        const parse_node_ptr<ParseContext>& get_prefix() const {
+            return m_prefix;
+        }
+
+        const std::vector<parse_node_ptr<ParseContext>>& get_parse_nodes() const {
+            return m_parse_nodes;
+        }
+
+        const std::vector<std::optional<id_type>>& get_ids() const {
+            return m_ids;
+        }
+
+        parse_result parse(ParseContext& pc) const override {
+            const auto from_state = pc.get_match_parse_state();
+            const size_t partition = pc.open_partition(from_state.get_iterator());
+            const parse_result result = parse_alternatives(pc, from_state);
+            pc.close_partition(partition);
+            return result;
+        }
+
+        bool analyze(grammar_analysis<ParseContext>& analysis) const override {
+            const bool prefix_nullable = analysis.analyze(m_prefix.get());
+            bool nullable = false;
+            for (const parse_node_ptr<ParseContext>& parse_node : m_parse_nodes) {
+                if (analysis.analyze(parse_node.get(), prefix_nullable)) {
+                    nullable = true;
+                }
+            }
+            return prefix_nullable && nullable;
+        }
+
+        parse_node_ptr<ParseContext> optimize(grammar_optimizer<ParseContext>& optimizer) override {
+            m_prefix = optimizer.optimize(m_prefix);
+            for (parse_node_ptr<ParseContext>& parse_node : m_parse_nodes) {
+                parse_node = optimizer.optimize(parse_node);
+            }
+            return {};
+        }
+
+    private:
+        parse_node_ptr<ParseContext> m_prefix;
+        std::vector<parse_node_ptr<ParseContext>> m_parse_nodes;
+        std::vector<std::optional<id_type>> m_ids;
+
+        parse_result parse_alternatives(ParseContext& pc, const typename ParseContext::parse_state_type& from_state) const {
+            const auto base_checkpoint = pc.get_checkpoint();
+
+            const parse_result prefix_result = m_prefix->parse(pc);
+            if (!prefix_result) {
+                return prefix_result;
+            }
+
+            const auto prefix_checkpoint = pc.get_checkpoint();
+
+            for (size_t index = 0; index < m_parse_nodes.size(); ++index) {
+                const parse_result result = m_parse_nodes[index]->parse(pc);
+                if (result) {
+                    if (m_ids[index]) {
+                        pc.add_match(*m_ids[index], from_state);
+                    }
+                    return true;
+                }
+
+                if (!pc.restore_checkpoint(prefix_checkpoint)) {
+                    return result;
+                }
+
+                if (result.is_left_recursion()) {
+                    pc.restore_checkpoint(base_checkpoint);
+                    return result;
+                }
+            }
+
+            pc.restore_checkpoint(base_checkpoint);
+            return false;
+        }
+    };
+
+
+} //namespace parserlib
+
+
+#endif //PARSERLIB_FACTORED_CHOICE_PARSE_NODE_HPP
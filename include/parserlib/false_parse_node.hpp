@@ -11,9 +11,17 @@ namespace parserlib {
     template <class ParseContext>
     class false_parse_node : public parse_node<ParseContext> {
     public:
-        bool parse(ParseContext& pc) const override {
+        parse_result parse(ParseContext& pc) const override {
             return false;
         }
+
+        bool analyze(grammar_analysis<ParseContext>&) const override {
+            return false;
+        }
+
+        void compile(bytecode_compiler<ParseContext>& compiler) const override {
+            compiler.compile_false();
+        }
     };
 
 
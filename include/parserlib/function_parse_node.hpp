@@ -16,7 +16,7 @@ namespace parserlib {
         {
         }
 
-        bool parse(ParseContext& pc) const override {
+        parse_result parse(ParseContext& pc) const override {
             return m_function(pc);
         }
 
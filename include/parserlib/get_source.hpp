@@ -5,6 +5,7 @@
 #include <type_traits>
 #include <algorithm>
 #include <string>
+#include <iterator>
 #include "match.hpp"
 #include "error.hpp"
 
@@ -39,7 +40,7 @@ namespace parserlib {
     struct get_source_impl<source_partition<Iterator, Id>> {
         template <class Iterator1>
         static auto get_source(const Iterator1& begin, const Iterator1& end) {
-            using value_type = std::decay_t<typename Iterator::value_type>;
+            using value_type = std::decay_t<typename std::iterator_traits<Iterator>::value_type>;
             return get_source_impl<value_type>::get_source(begin->begin(), begin != end ? std::prev(end)->end() : end->end());
         }
     };
@@ -57,7 +58,7 @@ namespace parserlib {
 
     template <class Iterator, class Id>
     auto get_source(const source_partition<Iterator, Id>& partition) {
-        using value_type = std::decay_t<typename Iterator::value_type>;
+        using value_type = std::decay_t<typename std::iterator_traits<Iterator>::value_type>;
         return get_source_impl<value_type>::get_source(partition.begin(), partition.end());
     }
 
@@ -0,0 +1,334 @@
+#ifndef PARSERLIB_GRAMMAR_ANALYSIS_HPP
+#define PARSERLIB_GRAMMAR_ANALYSIS_HPP
+
+
+#include <vector>
+#include <unordered_map>
+#include <algorithm>
+#include <type_traits>
+#include <utility>
+#include "rule.hpp"
+
+
+namespace parserlib {
+
+
+    class first_set {
+    public:
+        const std::vector<std::pair<int, int>>& get_ranges() const {
+            return m_ranges;
+        }
+
+        bool is_any() const {
+            return m_any;
+        }
+
+        void add(int min, int max) {
+            const std::pair<int, int> range(min, max);
+            auto it = std::lower_bound(m_ranges.begin(), m_ranges.end(), range);
+            if (it == m_ranges.end() || *it != range) {
+                m_ranges.insert(it, range);
+            }
+        }
+
+        void add(const first_set& set) {
+            for (const auto& [min, max] : set.m_ranges) {
+                add(min, max);
+            }
+            if (set.m_any) {
+                m_any = true;
+            }
+        }
+
+        void set_any() {
+            m_any = true;
+        }
+
+        template <class ParseContext>
+        bool contains(int symbol) const {
+            if (m_any) {
+                return true;
+            }
+            for (const auto& [min, max] : m_ranges) {
+                if (ParseContext::compare(symbol, min) >= 0 && ParseContext::compare(symbol, max) <= 0) {
+                    return true;
+                }
+            }
+            return false;
+        }
+
+        bool operator == (const first_set& set) const {
+            return m_any == set.m_any && m_ranges == set.m_ranges;
+        }
+
+        bool operator != (const first_set& set) const {
+            return !operator == (set);
+        }
+
+    private:
+        std::vector<std::pair<int, int>> m_ranges;
+        bool m_any{ false };
+    };
+
+
+    template <class ParseContext>
+    class grammar_analysis {
+    public:
+        using parse_node_type = parse_node<ParseContext>;
+        using rule_parse_node_type = rule_parse_node<ParseContext>;
+
+        static constexpr size_t npos = static_cast<size_t>(-1);
+
+        grammar_analysis() {
+        }
+
+        grammar_analysis(const parse_node_ptr<ParseContext>& grammar) {
+            analyze_grammar(grammar.get());
+        }
+
+        void analyze_grammar(parse_node_type* grammar) {
+            for (;;) {
+                m_changed = false;
+
+                m_rule_index = npos;
+                m_left = true;
+                analyze(grammar);
+
+                for (size_t rule_index = 0; rule_index < m_rules.size(); ++rule_index) {
+                    m_rule_index = rule_index;
+                    m_left = true;
+                    m_first_sets.emplace_back();
+                    parse_node_type* body = m_rules[rule_index].m_rule->get_parse_node().get();
+                    const bool nullable = body ? analyze(body) : analyze_opaque();
+                    if (nullable != m_rules[rule_index].m_nullable) {
+                        m_rules[rule_index].m_nullable = nullable;
+                        m_changed = true;
+                    }
+                    if (m_first_sets.back() != m_rules[rule_index].m_first_set) {
+                        m_rules[rule_index].m_first_set = std::move(m_first_sets.back());
+                        m_changed = true;
+                    }
+                    m_first_sets.pop_back();
+                }
+
+                if (!m_changed) {
+                    break;
+                }
+            }
+
+            for (size_t rule_index = 0; rule_index < m_rules.size(); ++rule_index) {
+                m_rules[rule_index].m_left_recursive = is_left_reachable(rule_index);
+            }
+        }
+
+        bool analyze(parse_node_type* parse_node, bool left = true) {
+            const bool prev_left = m_left;
+            m_left = m_left && left;
+            m_first_sets.emplace_back();
+            const bool nullable = parse_node->analyze(*this);
+            node_info& info = m_nodes[parse_node];
+            info.m_nullable = nullable;
+            info.m_first_set = std::move(m_first_sets.back());
+            m_first_sets.pop_back();
+            if (left) {
+                add_first_set(info.m_first_set);
+            }
+            m_left = prev_left;
+            return nullable;
+        }
+
+        template <class Expression>
+        bool analyze_expression(const Expression& expression, bool left = true) {
+            const bool prev_left = m_left;
+            m_left = m_left && left;
+            m_first_sets.emplace_back();
+            const bool nullable = expression.analyze(*this);
+            const first_set set = std::move(m_first_sets.back());
+            m_first_sets.pop_back();
+            if (left) {
+                add_first_set(set);
+            }
+            m_left = prev_left;
+            return nullable;
+        }
+
+        template <class Symbol>
+        bool analyze_symbol(const Symbol& symbol) {
+            return analyze_range(symbol, symbol);
+        }
+
+        template <class Symbol>
+        bool analyze_range(const Symbol& min, const Symbol& max) {
+            if constexpr (std::is_integral_v<Symbol> || std::is_enum_v<Symbol>) {
+                if (!m_first_sets.empty()) {
+                    m_first_sets.back().add(static_cast<int>(min), static_cast<int>(max));
+                }
+                return false;
+            }
+            else {
+                return analyze_any();
+            }
+        }
+
+        bool analyze_any() {
+            if (!m_first_sets.empty()) {
+                m_first_sets.back().set_any();
+            }
+            return false;
+        }
+
+        bool analyze_rule(const rule_parse_node_type* rule) {
+            auto it = m_rule_indexes.find(rule);
+            if (it == m_rule_indexes.end()) {
+                it = m_rule_indexes.emplace(rule, m_rules.size()).first;
+                m_rules.push_back(rule_info(rule));
+                m_changed = true;
+            }
+            const size_t rule_index = it->second;
+            add_first_set(m_rules[rule_index].m_first_set);
+            if (m_left && m_rule_index != npos) {
+                std::vector<size_t>& left_rules = m_rules[m_rule_index].m_left_rules;
+                if (std::find(left_rules.begin(), left_rules.end(), rule_index) == left_rules.end()) {
+                    left_rules.push_back(rule_index);
+                    m_changed = true;
+                }
+            }
+            return m_rules[rule_index].m_nullable;
+        }
+
+        bool analyze_cut() {
+            m_reaches_cut = true;
+            return true;
+        }
+
+        bool analyze_opaque() {
+            analyze_any();
+            if (m_left && m_rule_index != npos && !m_rules[m_rule_index].m_left_opaque) {
+                m_rules[m_rule_index].m_left_opaque = true;
+                m_changed = true;
+            }
+            return true;
+        }
+
+        bool is_left() const {
+            return m_left;
+        }
+
+        bool reaches_cut() const {
+            return m_reaches_cut;
+        }
+
+        bool is_nullable(const parse_node_type* parse_node) const {
+            auto it = m_nodes.find(parse_node);
+            return it != m_nodes.end() ? it->second.m_nullable : true;
+        }
+
+        const first_set& get_first_set(const parse_node_type* parse_node) const {
+            auto it = m_nodes.find(parse_node);
+            return it != m_nodes.end() ? it->second.m_first_set : get_any_first_set();
+        }
+
+        bool is_left_recursive(const rule_parse_node_type* rule) const {
+            auto it = m_rule_indexes.find(rule);
+            return it != m_rule_indexes.end() ? m_rules[it->second].m_left_recursive : true;
+        }
+
+        size_t get_rule_index(const rule_parse_node_type* rule) const {
+            auto it = m_rule_indexes.find(rule);
+            return it != m_rule_indexes.end() ? it->second : ParseContext::npos_rule_index;
+        }
+
+        size_t get_rule_count() const {
+            return m_rules.size();
+        }
+
+        void freeze() const {
+            for (const auto& [parse_node, info] : m_nodes) {
+                const_cast<parse_node_type*>(parse_node)->freeze(*this);
+            }
+        }
+
+    private:
+        struct rule_info {
+            rule_info(const rule_parse_node_type* rule)
+                : m_rule(rule)
+            {
+            }
+
+            const rule_parse_node_type* m_rule;
+            std::vector<size_t> m_left_rules;
+            bool m_nullable{ false };
+            bool m_left_opaque{ false };
+            bool m_left_recursive{ true };
+            first_set m_first_set;
+        };
+
+        struct node_info {
+            bool m_nullable{ true };
+            first_set m_first_set;
+        };
+
+        std::vector<rule_info> m_rules;
+        std::unordered_map<const rule_parse_node_type*, size_t> m_rule_indexes;
+        std::unordered_map<const parse_node_type*, node_info> m_nodes;
+        std::vector<first_set> m_first_sets;
+        size_t m_rule_index{ npos };
+        bool m_left{ true };
+        bool m_changed{ false };
+        bool m_reaches_cut{ false };
+
+        static const first_set& get_any_first_set() {
+            static const first_set set = []() {
+                first_set result;
+                result.set_any();
+                return result;
+            }();
+            return set;
+        }
+
+        void add_first_set(const first_set& set) {
+            if (!m_first_sets.empty()) {
+                m_first_sets.back().add(set);
+            }
+        }
+
+        bool is_left_reachable(size_t rule_index) const {
+            std::vector<bool> visited(m_rules.size(), false);
+            std::vector<size_t> pending{ rule_index };
+            while (!pending.empty()) {
+                const rule_info& info = m_rules[pending.back()];
+                pending.pop_back();
+                if (info.m_left_opaque) {
+                    return true;
+                }
+                for (size_t left_rule_index : info.m_left_rules) {
+                    if (left_rule_index == rule_index) {
+                        return true;
+                    }
+                    if (!visited[left_rule_index]) {
+                        visited[left_rule_index] = true;
+                        pending.push_back(left_rule_index);
+                    }
+                }
+            }
+            return false;
+        }
+    };
+
+
+    template <class ParseContext>
+    void freeze(const parse_node_ptr<ParseContext>& grammar) {
+        grammar_analysis<ParseContext>(grammar).freeze();
+    }
+
+
+    template <class ParseContext>
+    void freeze(const rule<ParseContext>& grammar) {
+        freeze(grammar.m_parse_node);
+    }
+
+
+} //namespace parserlib
+
+
+#endif //PARSERLIB_GRAMMAR_ANALYSIS_HPP
@@ -0,0 +1,569 @@
+#ifndef PARSERLIB_GRAMMAR_OPTIMIZER_HPP
+#define PARSERLIB_GRAMMAR_OPTIMIZER_HPP
+
+
+#include <string>
+#include <vector>
+#include <unordered_map>
+#include <optional>
+#include <iterator>
+#include <typeinfo>
+#include <algorithm>
+#include <bitset>
+#include <type_traits>
+#include "symbol_parse_node.hpp"
+#include "string_parse_node.hpp"
+#include "set_parse_node.hpp"
+#include "range_parse_node.hpp"
+#include "bool_parse_node.hpp"
+#include "loop_0_parse_node.hpp"
+#include "loop_1_parse_node.hpp"
+#include "optional_parse_node.hpp"
+#include "sequence_parse_node.hpp"
+#include "choice_parse_node.hpp"
+#include "match_parse_node.hpp"
+#include "factored_choice_parse_node.hpp"
+#include "span_parse_node.hpp"
+#include "class_symbols.hpp"
+#include "one_of_parse_node.hpp"
+#include "any_parse_node.hpp"
+#include "logical_not_parse_node.hpp"
+#include "until_parse_node.hpp"
+#include "grammar_analysis.hpp"
+
+
+namespace parserlib {
+
+
+    class optimization_report {
+    public:
+        size_t get_merged_string_count() const {
+            return m_merged_string_count;
+        }
+
+        size_t get_merged_set_count() const {
+            return m_merged_set_count;
+        }
+
+        size_t get_folded_bool_count() const {
+            return m_folded_bool_count;
+        }
+
+        size_t get_flattened_count() const {
+            return m_flattened_count;
+        }
+
+        size_t get_removed_loop_count() const {
+            return m_removed_loop_count;
+        }
+
+        size_t get_removed_ref_count() const {
+            return m_removed_ref_count;
+        }
+
+        size_t get_factored_count() const {
+            return m_factored_count;
+        }
+
+        size_t get_span_count() const {
+            return m_span_count;
+        }
+
+        size_t get_one_of_count() const {
+            return m_one_of_count;
+        }
+
+        size_t get_until_count() const {
+            return m_until_count;
+        }
+
+        size_t get_change_count() const {
+            return m_merged_string_count + m_merged_set_count + m_folded_bool_count + m_flattened_count + m_removed_loop_count + m_removed_ref_count + m_factored_count + m_span_count + m_one_of_count + m_until_count;
+        }
+
+    private:
+        size_t m_merged_string_count{ 0 };
+        size_t m_merged_set_count{ 0 };
+        size_t m_folded_bool_count{ 0 };
+        size_t m_flattened_count{ 0 };
+        size_t m_removed_loop_count{ 0 };
+        size_t m_removed_ref_count{ 0 };
+        size_t m_factored_count{ 0 };
+        size_t m_span_count{ 0 };
+        size_t m_one_of_count{ 0 };
+        size_t m_until_count{ 0 };
+
+        template <class ParseContext>
+        friend class grammar_optimizer;
+    };
+
+
+    template <class ParseContext>
+    class grammar_optimizer {
+    public:
+        using parse_node_type = parse_node<ParseContext>;
+        using token_type = typename std::iterator_traits<typename ParseContext::iterator_type>::value_type;
+        using symbol_type = std::conditional_t<std::is_integral_v<token_type>, token_type, char>;
+
+        static constexpr int max_merged_range_size = 256;
+
+        static constexpr size_t min_one_of_size = 4;
+
+        const optimization_report& get_report() const {
+            return m_report;
+        }
+
+        parse_node_ptr<ParseContext> optimize(const parse_node_ptr<ParseContext>& parse_node) {
+            if (!parse_node.get()) {
+                return parse_node;
+            }
+
+            auto it = m_parse_nodes.find(parse_node.get());
+            if (it != m_parse_nodes.end()) {
+                return it->second;
+            }
+
+            m_parse_nodes.emplace(parse_node.get(), parse_node);
+            parse_node_ptr<ParseContext> result = parse_node->optimize(*this);
+            if (!result.get()) {
+                return parse_node;
+            }
+            m_parse_nodes[parse_node.get()] = result;
+            return result;
+        }
+
+        parse_node_ptr<ParseContext> optimize_sequence(std::vector<parse_node_ptr<ParseContext>>& parse_nodes) {
+            std::vector<parse_node_ptr<ParseContext>> result;
+            std::basic_string<symbol_type> prev_string, string;
+
+            for (const parse_node_ptr<ParseContext>& parse_node : parse_nodes) {
+                if (const auto* sequence = dynamic_cast<const sequence_parse_node<ParseContext>*>(parse_node.get())) {
+                    result.insert(result.end(), sequence->get_parse_nodes().begin(), sequence->get_parse_nodes().end());
+                    ++m_report.m_flattened_count;
+                }
+                else if (dynamic_cast<const true_parse_node<ParseContext>*>(parse_node.get())) {
+                    ++m_report.m_folded_bool_count;
+                }
+                else if (!result.empty() && get_string(result.back(), prev_string) && get_string(parse_node, string)) {
+                    result.back() = std::make_shared<string_parse_node<ParseContext, symbol_type>>(prev_string + string);
+                    ++m_report.m_merged_string_count;
+                }
+                else {
+                    result.push_back(parse_node);
+                }
+            }
+
+            if (result.empty()) {
+                return true;
+            }
+
+            if (result.size() > 1 && dynamic_cast<const false_parse_node<ParseContext>*>(result.front().get())) {
+                ++m_report.m_folded_bool_count;
+                return false;
+            }
+
+            if (result.size() == 1) {
+                return result.front();
+            }
+
+            parse_nodes = std::move(result);
+            return {};
+        }
+
+        parse_node_ptr<ParseContext> optimize_choice(std::vector<parse_node_ptr<ParseContext>>& parse_nodes) {
+            std::vector<parse_node_ptr<ParseContext>> result;
+
+            for (size_t index = 0; index < parse_nodes.size(); ++index) {
+                const parse_node_ptr<ParseContext>& parse_node = parse_nodes[index];
+                if (const auto* choice = dynamic_cast<const choice_parse_node<ParseContext>*>(parse_node.get())) {
+                    result.insert(result.end(), choice->get_parse_nodes().begin(), choice->get_parse_nodes().end());
+                    ++m_report.m_flattened_count;
+                }
+                else if (dynamic_cast<const false_parse_node<ParseContext>*>(parse_node.get())) {
+                    ++m_report.m_folded_bool_count;
+                }
+                else {
+                    result.push_back(parse_node);
+                    if (dynamic_cast<const true_parse_node<ParseContext>*>(parse_node.get()) && index + 1 < parse_nodes.size()) {
+                        m_report.m_folded_bool_count += parse_nodes.size() - index - 1;
+                        break;
+                    }
+                }
+            }
+
+            result = factor_alternatives(result);
+
+            if constexpr (std::is_integral_v<token_type> && one_of_parse_node<ParseContext>::is_keyed_comparator) {
+                result = merge_strings(result);
+            }
+
+            if constexpr (std::is_integral_v<token_type> && std::is_same_v<typename ParseContext::symbol_comparator_type, default_symbol_comparator>) {
+                std::vector<parse_node_ptr<ParseContext>> merged, set_parse_nodes;
+                std::basic_string<symbol_type> set, symbols;
+
+                for (const parse_node_ptr<ParseContext>& parse_node : result) {
+                    if (get_set(parse_node, symbols)) {
+                        set += symbols;
+                        set_parse_nodes.push_back(parse_node);
+                        continue;
+                    }
+                    append_set(merged, set_parse_nodes, set);
+                    merged.push_back(parse_node);
+                }
+                append_set(merged, set_parse_nodes, set);
+
+                result = std::move(merged);
+            }
+
+            if (result.empty()) {
+                return false;
+            }
+
+            if (result.size() == 1) {
+                return result.front();
+            }
+
+            parse_nodes = std::move(result);
+            return {};
+        }
+
+        parse_node_ptr<ParseContext> optimize_loop_0(parse_node_ptr<ParseContext>& parse_node) {
+            if (dynamic_cast<const loop_0_parse_node<ParseContext>*>(parse_node.get())) {
+                ++m_report.m_removed_loop_count;
+                return parse_node;
+            }
+            if (const auto* loop = dynamic_cast<const loop_1_parse_node<ParseContext>*>(parse_node.get())) {
+                ++m_report.m_removed_loop_count;
+                parse_node = loop->get_parse_node();
+                return {};
+            }
+            if (const auto* optional = dynamic_cast<const optional_parse_node<ParseContext>*>(parse_node.get())) {
+                ++m_report.m_removed_loop_count;
+                parse_node = optional->get_parse_node();
+                return {};
+            }
+            if (dynamic_cast<const false_parse_node<ParseContext>*>(parse_node.get())) {
+                ++m_report.m_folded_bool_count;
+                return true;
+            }
+            if (is_span(parse_node)) {
+                return remove_span_loop(parse_node, 0);
+            }
+            if (parse_node_ptr<ParseContext> until = make_until(parse_node); until.get()) {
+                return until;
+            }
+            return make_span(parse_node, 0);
+        }
+
+        parse_node_ptr<ParseContext> optimize_loop_1(parse_node_ptr<ParseContext>& parse_node) {
+            if (dynamic_cast<const loop_0_parse_node<ParseContext>*>(parse_node.get()) || dynamic_cast<const loop_1_parse_node<ParseContext>*>(parse_node.get())) {
+                ++m_report.m_removed_loop_count;
+                return parse_node;
+            }
+            if (dynamic_cast<const false_parse_node<ParseContext>*>(parse_node.get())) {
+                ++m_report.m_folded_bool_count;
+                return false;
+            }
+            if (is_span(parse_node)) {
+                ++m_report.m_removed_loop_count;
+                return parse_node;
+            }
+            return make_span(parse_node, 1);
+        }
+
+        parse_node_ptr<ParseContext> optimize_optional(parse_node_ptr<ParseContext>& parse_node) {
+            if (dynamic_cast<const loop_0_parse_node<ParseContext>*>(parse_node.get()) || dynamic_cast<const optional_parse_node<ParseContext>*>(parse_node.get())) {
+                ++m_report.m_removed_loop_count;
+                return parse_node;
+            }
+            if (dynamic_cast<const false_parse_node<ParseContext>*>(parse_node.get())) {
+                ++m_report.m_folded_bool_count;
+                return true;
+            }
+            if (is_span(parse_node)) {
+                return remove_span_loop(parse_node, 0);
+            }
+            return {};
+        }
+
+        parse_node_ptr<ParseContext> optimize_ref(const std::shared_ptr<rule_parse_node<ParseContext>>& rule) {
+            optimize(rule);
+            ++m_report.m_removed_ref_count;
+            return rule;
+        }
+
+    private:
+        using match_id_type = typename ParseContext::match_id_type;
+
+        struct alternative {
+            std::optional<match_id_type> m_id;
+            std::vector<parse_node_ptr<ParseContext>> m_parse_nodes;
+        };
+
+        std::unordered_map<const parse_node_type*, parse_node_ptr<ParseContext>> m_parse_nodes;
+        optimization_report m_report;
+
+        static alternative get_alternative(const parse_node_ptr<ParseContext>& parse_node) {
+            alternative result;
+            parse_node_ptr<ParseContext> body = parse_node;
+            if (const auto* match = dynamic_cast<const match_parse_node<ParseContext>*>(parse_node.get())) {
+                result.m_id = match->get_id();
+                body = match->get_parse_node();
+            }
+            if (const auto* sequence = dynamic_cast<const sequence_parse_node<ParseContext>*>(body.get())) {
+                result.m_parse_nodes = sequence->get_parse_nodes();
+            }
+            else {
+                result.m_parse_nodes.push_back(body);
+            }
+            return result;
+        }
+
+        static parse_node_ptr<ParseContext> make_sequence(typename std::vector<parse_node_ptr<ParseContext>>::const_iterator begin, typename std::vector<parse_node_ptr<ParseContext>>::const_iterator end) {
+            if (begin == end) {
+                return true;
+            }
+            if (std::next(begin) == end) {
+                return *begin;
+            }
+            return std::make_shared<sequence_parse_node<ParseContext>>(std::vector<parse_node_ptr<ParseContext>>(begin, end));
+        }
+
+        std::vector<parse_node_ptr<ParseContext>> factor_alternatives(const std::vector<parse_node_ptr<ParseContext>>& parse_nodes) {
+            std::vector<parse_node_ptr<ParseContext>> result;
+
+            for (size_t index = 0; index < parse_nodes.size();) {
+                std::vector<alternative> group{ get_alternative(parse_nodes[index]) };
+                size_t prefix_size = group.front().m_parse_nodes.size();
+
+                for (size_t next_index = index + 1; next_index < parse_nodes.size(); ++next_index) {
+                    alternative next = get_alternative(parse_nodes[next_index]);
+                    size_t common_size = 0;
+                    while (common_size < prefix_size && common_size < next.m_parse_nodes.size() && is_same_parse_node(group.front().m_parse_nodes[common_size], next.m_parse_nodes[common_size])) {
+                        ++common_size;
+                    }
+                    if (common_size == 0) {
+                        break;
+                    }
+                    prefix_size = common_size;
+                    group.push_back(std::move(next));
+                }
+
+                if (group.size() == 1) {
+                    result.push_back(parse_nodes[index]);
+                    ++index;
+                    continue;
+                }
+
+                const parse_node_ptr<ParseContext> prefix = make_sequence(group.front().m_parse_nodes.begin(), group.front().m_parse_nodes.begin() + prefix_size);
+
+                if (grammar_analysis<ParseContext>(prefix).reaches_cut()) {
+                    result.push_back(parse_nodes[index]);
+                    ++index;
+                    continue;
+                }
+
+                std::vector<parse_node_ptr<ParseContext>> suffixes;
+                std::vector<std::optional<match_id_type>> ids;
+                bool has_ids = false;
+                for (const alternative& alt : group) {
+                    suffixes.push_back(make_sequence(alt.m_parse_nodes.begin() + prefix_size, alt.m_parse_nodes.end()));
+                    ids.push_back(alt.m_id);
+                    if (alt.m_id) {
+                        has_ids = true;
+                    }
+                }
+
+                if (has_ids) {
+                    result.push_back(std::make_shared<factored_choice_parse_node<ParseContext>>(prefix, suffixes, ids));
+                }
+                else {
+                    parse_node_ptr<ParseContext> suffix = optimize_choice(suffixes);
+                    if (!suffix.get()) {
+                        suffix = std::make_shared<choice_parse_node<ParseContext>>(suffixes);
+                    }
+                    std::vector<parse_node_ptr<ParseContext>> sequence(group.front().m_parse_nodes.begin(), group.front().m_parse_nodes.begin() + prefix_size);
+                    sequence.push_back(suffix);
+                    result.push_back(std::make_shared<sequence_parse_node<ParseContext>>(sequence));
+                }
+
+                m_report.m_factored_count += group.size();
+                index += group.size();
+            }
+
+            return result;
+        }
+
+        std::vector<parse_node_ptr<ParseContext>> merge_strings(const std::vector<parse_node_ptr<ParseContext>>& parse_nodes) {
+            std::vector<parse_node_ptr<ParseContext>> result;
+            std::basic_string<symbol_type> string;
+
+            for (size_t index = 0; index < parse_nodes.size();) {
+                std::vector<std::vector<int>> strings;
+                bool has_long_string = false;
+                size_t end_index = index;
+                for (; end_index < parse_nodes.size() && get_string(parse_nodes[end_index], string); ++end_index) {
+                    strings.emplace_back(string.begin(), string.end());
+                    if (string.size() > 1) {
+                        has_long_string = true;
+                    }
+                }
+
+                if (strings.size() >= min_one_of_size && has_long_string) {
+                    result.push_back(std::make_shared<one_of_parse_node<ParseContext>>(strings));
+                    m_report.m_one_of_count += strings.size();
+                    index = end_index;
+                }
+                else {
+                    result.insert(result.end(), parse_nodes.begin() + index, parse_nodes.begin() + std::max(end_index, index + 1));
+                    index = std::max(end_index, index + 1);
+                }
+            }
+
+            return result;
+        }
+
+        static bool is_same_parse_node(const parse_node_ptr<ParseContext>& a, const parse_node_ptr<ParseContext>& b) {
+            if (a.get() == b.get()) {
+                return true;
+            }
+            if (typeid(*a.get()) != typeid(*b.get())) {
+                return false;
+            }
+            std::basic_string<symbol_type> string_a, string_b;
+            if (get_string(a, string_a) && get_string(b, string_b)) {
+                return string_a == string_b;
+            }
+            if constexpr (std::is_integral_v<token_type>) {
+                if (const auto* range_a = dynamic_cast<const range_parse_node<ParseContext, symbol_type>*>(a.get())) {
+                    const auto* range_b = static_cast<const range_parse_node<ParseContext, symbol_type>*>(b.get());
+                    return range_a->get_min() == range_b->get_min() && range_a->get_max() == range_b->get_max();
+                }
+                if (const auto* set_a = dynamic_cast<const set_parse_node<ParseContext, symbol_type>*>(a.get())) {
+                    return set_a->get_set() == static_cast<const set_parse_node<ParseContext, symbol_type>*>(b.get())->get_set();
+                }
+            }
+            return false;
+        }
+
+        static bool get_string(const parse_node_ptr<ParseContext>& parse_node, std::basic_string<symbol_type>& string) {
+            if constexpr (std::is_integral_v<token_type>) {
+                if (const auto* symbol = dynamic_cast<const symbol_parse_node<ParseContext, symbol_type>*>(parse_node.get())) {
+                    string.assign(1, symbol->get_symbol());
+                    return true;
+                }
+                if (const auto* str = dynamic_cast<const string_parse_node<ParseContext, symbol_type>*>(parse_node.get())) {
+                    string = str->get_string();
+                    return true;
+                }
+            }
+            return false;
+        }
+
+        static bool get_set(const parse_node_ptr<ParseContext>& parse_node, std::basic_string<symbol_type>& set) {
+            if constexpr (std::is_integral_v<token_type>) {
+                if (const auto* symbol = dynamic_cast<const symbol_parse_node<ParseContext, symbol_type>*>(parse_node.get())) {
+                    set.assign(1, symbol->get_symbol());
+                    return true;
+                }
+                if (const auto* symbols = dynamic_cast<const set_parse_node<ParseContext, symbol_type>*>(parse_node.get())) {
+                    set.assign(symbols->get_set().begin(), symbols->get_set().end());
+                    return true;
+                }
+                if (const auto* range = dynamic_cast<const range_parse_node<ParseContext, symbol_type>*>(parse_node.get())) {
+                    if (static_cast<int>(range->get_max()) - static_cast<int>(range->get_min()) < max_merged_range_size) {
+                        set.clear();
+                        for (int symbol = static_cast<int>(range->get_min()); symbol <= static_cast<int>(range->get_max()); ++symbol) {
+                            set.push_back(static_cast<symbol_type>(symbol));
+                        }
+                        return true;
+                    }
+                }
+            }
+            return false;
+        }
+
+        static bool is_span(const parse_node_ptr<ParseContext>& parse_node) {
+            if constexpr (std::is_integral_v<token_type> && sizeof(token_type) == 1) {
+                return dynamic_cast<const span_parse_node<ParseContext>*>(parse_node.get()) != nullptr;
+            }
+            else {
+                return false;
+            }
+        }
+
+        parse_node_ptr<ParseContext> remove_span_loop(const parse_node_ptr<ParseContext>& parse_node, size_t min_count) {
+            if constexpr (std::is_integral_v<token_type> && sizeof(token_type) == 1) {
+                ++m_report.m_removed_loop_count;
+                const auto* span = static_cast<const span_parse_node<ParseContext>*>(parse_node.get());
+                if (span->get_min_count() == min_count) {
+                    return parse_node;
+                }
+                return std::make_shared<span_parse_node<ParseContext>>(span->get_parse_node(), span->get_symbols(), min_count);
+            }
+            else {
+                return parse_node;
+            }
+        }
+
+        parse_node_ptr<ParseContext> make_span(const parse_node_ptr<ParseContext>& parse_node, size_t min_count) {
+            if constexpr (std::is_integral_v<token_type> && sizeof(token_type) == 1) {
+                std::bitset<256> symbols;
+                if (get_class_symbols(parse_node, symbols)) {
+                    ++m_report.m_span_count;
+                    return std::make_shared<span_parse_node<ParseContext>>(parse_node, symbols, min_count);
+                }
+            }
+            return {};
+        }
+
+        parse_node_ptr<ParseContext> make_until(const parse_node_ptr<ParseContext>& parse_node) {
+            if constexpr (std::is_integral_v<token_type>) {
+                const auto* sequence = dynamic_cast<const sequence_parse_node<ParseContext>*>(parse_node.get());
+                if (!sequence || sequence->get_parse_nodes().size() != 2 || !dynamic_cast<const any_parse_node<ParseContext>*>(sequence->get_parse_nodes().back().get())) {
+                    return {};
+                }
+                const auto* logical_not = dynamic_cast<const logical_not_parse_node<ParseContext>*>(sequence->get_parse_nodes().front().get());
+                std::basic_string<symbol_type> terminator;
+                if (logical_not && get_string(logical_not->get_parse_node(), terminator) && !terminator.empty()) {
+                    ++m_report.m_until_count;
+                    return std::make_shared<until_parse_node<ParseContext, symbol_type>>(terminator);
+                }
+            }
+            return {};
+        }
+
+        void append_set(std::vector<parse_node_ptr<ParseContext>>& parse_nodes, std::vector<parse_node_ptr<ParseContext>>& set_parse_nodes, std::basic_string<symbol_type>& set) {
+            if (set_parse_nodes.size() == 1) {
+                parse_nodes.push_back(set_parse_nodes.front());
+            }
+            else if (set_parse_nodes.size() > 1) {
+                parse_nodes.push_back(std::make_shared<set_parse_node<ParseContext, symbol_type>>(set));
+                m_report.m_merged_set_count += set_parse_nodes.size();
+            }
+            set_parse_nodes.clear();
+            set.clear();
+        }
+    };
+
+
+    template <class ParseContext>
+    optimization_report optimize(parse_node_ptr<ParseContext>& grammar) {
+        grammar_optimizer<ParseContext> optimizer;
+        grammar = optimizer.optimize(grammar);
+        return optimizer.get_report();
+    }
+
+
+    template <class ParseContext>
+    optimization_report optimize(rule<ParseContext>& grammar) {
+        grammar_optimizer<ParseContext> optimizer;
+        optimizer.optimize(grammar.m_parse_node);
+        return optimizer.get_report();
+    }
+
+
+} //namespace parserlib
+
+
+#endif //PARSERLIB_GRAMMAR_OPTIMIZER_HPP
@@ -0,0 +1,75 @@
+#ifndef PARSERLIB_IDENTIFIER_PARSE_NODE_HPP
+#define PARSERLIB_IDENTIFIER_PARSE_NODE_HPP
+
+
+#include <bitset>
+#include "parse_node_ptr.hpp"
+#include "sequence_parse_node.hpp"
+#include "loop_0_parse_node.hpp"
+#include "class_symbols.hpp"
+#include "lexeme_cursor.hpp"
+
+
+namespace parserlib {
+
+
+    template <class ParseContext>
+    class identifier_parse_node : public parse_node<ParseContext> {
+    public:
+        identifier_parse_node(const parse_node_ptr<ParseContext>& first, const parse_node_ptr<ParseContext>& rest)
+            : m_parse_node(first >> *rest)
+        {
+            std::bitset<256> first_symbols, rest_symbols;
+            if (get_class_symbols(first, first_symbols) && get_class_symbols(rest, rest_symbols)) {
+                m_first_symbols = symbol_class(first_symbols);
+                m_rest_symbols = symbol_class(rest_symbols);
+                m_classified = true;
+            }
+        }
+
+        const parse_node_ptr<ParseContext>& get_parse_node() const {
+            return m_parse_node;
+        }
+
+        bool is_classified() const {
+            return m_classified;
+        }
+
+        parse_result parse(ParseContext& pc) const override {
+            if (!m_classified) {
+                return m_parse_node->parse(pc);
+            }
+            lexeme_cursor<ParseContext> cursor(pc);
+            if (!cursor.accept(m_first_symbols)) {
+                return false;
+            }
+            cursor.accept_span(m_rest_symbols);
+            pc.increment_iterator(cursor.get_count());
+            return true;
+        }
+
+        bool analyze(grammar_analysis<ParseContext>& analysis) const override {
+            return analysis.analyze(m_parse_node.get());
+        }
+
+        void compile(bytecode_compiler<ParseContext>& compiler) const override {
+            compiler.compile_parse_node(this);
+        }
+
+        parse_node_ptr<ParseContext> optimize(grammar_optimizer<ParseContext>& optimizer) override {
+            m_parse_node = optimizer.optimize(m_parse_node);
+            return {};
+        }
+
+    private:
+        parse_node_ptr<ParseContext> m_parse_node;
+        symbol_class m_first_symbols;
+        symbol_class m_rest_symbols;
+        bool m_classified{ false };
+    };
+
+
+} //namespace parserlib
+
+
+#endif //PARSERLIB_IDENTIFIER_PARSE_NODE_HPP
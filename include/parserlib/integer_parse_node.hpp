@@ -0,0 +1,50 @@
+#ifndef PARSERLIB_INTEGER_PARSE_NODE_HPP
+#define PARSERLIB_INTEGER_PARSE_NODE_HPP
+
+
+#include "parse_node_ptr.hpp"
+#include "number_scanner.hpp"
+
+
+namespace parserlib {
+
+
+    template <class ParseContext>
+    class integer_parse_node : public parse_node<ParseContext> {
+    public:
+        integer_parse_node(number_sign sign = number_sign::none)
+            : m_sign(sign)
+        {
+        }
+
+        number_sign get_sign() const {
+            return m_sign;
+        }
+
+        parse_result parse(ParseContext& pc) const override {
+            return scan_number(pc, [&](auto& scanner) { return scanner.scan_integer(m_sign); });
+        }
+
+        bool analyze(grammar_analysis<ParseContext>& analysis) const override {
+            if (m_sign != number_sign::none) {
+                analysis.analyze_symbol('-');
+            }
+            if (m_sign == number_sign::plus_minus) {
+                analysis.analyze_symbol('+');
+            }
+            return analysis.analyze_range('0', '9');
+        }
+
+        void compile(bytecode_compiler<ParseContext>& compiler) const override {
+            compiler.compile_parse_node(this);
+        }
+
+    private:
+        number_sign m_sign;
+    };
+
+
+} //namespace parserlib
+
+
+#endif //PARSERLIB_INTEGER_PARSE_NODE_HPP
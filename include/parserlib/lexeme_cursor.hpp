@@ -0,0 +1,108 @@
+#ifndef PARSERLIB_LEXEME_CURSOR_HPP
+#define PARSERLIB_LEXEME_CURSOR_HPP
+
+
+#include <bitset>
+#include <iterator>
+#include <type_traits>
+#include "contiguous_iterator.hpp"
+#include "symbol_class.hpp"
+
+
+namespace parserlib {
+
+
+    template <class ParseContext>
+    class lexeme_cursor {
+    public:
+        using iterator_type = typename ParseContext::iterator_type;
+        using token_type = std::remove_cv_t<typename std::iterator_traits<iterator_type>::value_type>;
+
+        static constexpr bool is_scanned = is_contiguous_iterator_v<iterator_type> && std::is_integral_v<token_type> && sizeof(token_type) == 1;
+
+        lexeme_cursor(const ParseContext& pc)
+            : m_iterator(pc.get_iterator())
+            , m_end(pc.get_end_iterator())
+        {
+        }
+
+        bool is_valid() const {
+            return m_iterator != m_end;
+        }
+
+        size_t get_count() const {
+            return m_count;
+        }
+
+        bool accept(const symbol_class& symbols) {
+            if (is_valid() && contains(symbols, *m_iterator)) {
+                ++m_iterator;
+                ++m_count;
+                return true;
+            }
+            return false;
+        }
+
+        size_t accept_span(const symbol_class& symbols) {
+            size_t count = 0;
+            if constexpr (is_scanned && is_padded_iterator_v<iterator_type>) {
+                count = symbols.scan_padded(reinterpret_cast<const unsigned char*>(get_iterator_address(m_iterator)), static_cast<size_t>(m_end - m_iterator));
+                m_iterator += count;
+            }
+            else if constexpr (is_scanned) {
+                const size_t size = static_cast<size_t>(m_end - m_iterator);
+                if (size > 0) {
+                    count = symbols.scan(reinterpret_cast<const unsigned char*>(get_iterator_address(m_iterator)), size);
+                    m_iterator += count;
+                }
+            }
+            else if constexpr (is_segmented_iterator_v<iterator_type> && std::is_integral_v<token_type> && sizeof(token_type) == 1) {
+                for (;;) {
+                    const size_t size = get_segment_size(m_iterator, m_end);
+                    const size_t segment_count = size > 0 ? symbols.scan(reinterpret_cast<const unsigned char*>(get_iterator_address(m_iterator)), size) : 0;
+                    m_iterator += segment_count;
+                    count += segment_count;
+                    if (segment_count < size || size == 0) {
+                        break;
+                    }
+                }
+            }
+            else {
+                for (; is_valid() && contains(symbols, *m_iterator); ++m_iterator) {
+                    ++count;
+                }
+            }
+            m_count += count;
+            return count;
+        }
+
+        static bool contains(const symbol_class& symbols, const token_type& token) {
+            if constexpr (sizeof(token_type) == 1) {
+                return symbols.contains(token);
+            }
+            else {
+                const long long value = static_cast<long long>(token);
+                return value >= 0 && value < 256 && symbols.contains(value);
+            }
+        }
+
+    private:
+        iterator_type m_iterator;
+        iterator_type m_end;
+        size_t m_count{ 0 };
+    };
+
+
+    inline symbol_class make_symbol_class(const char* symbols) {
+        std::bitset<256> result;
+        for (; *symbols; ++symbols) {
+            result[static_cast<unsigned char>(*symbols)] = true;
+        }
+        return symbol_class(result);
+    }
+
+
+} //namespace parserlib
+
+
+#endif //PARSERLIB_LEXEME_CURSOR_HPP
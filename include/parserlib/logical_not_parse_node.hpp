@@ -16,17 +16,34 @@ namespace parserlib {
         {
         }
 
-        bool parse(ParseContext& pc) const override {
-            const auto base_state = pc.get_state();
-            try {
-                const bool result = !m_parse_node->parse(pc);
-                pc.set_state(base_state);
+        const parse_node_ptr<ParseContext>& get_parse_node() const {
+            return m_parse_node;
+        }
+
+        parse_result parse(ParseContext& pc) const override {
+            const auto base_checkpoint = pc.get_checkpoint();
+            const size_t cut_scope = pc.begin_cut_scope();
+            const parse_result result = m_parse_node->parse(pc);
+            pc.end_cut_scope(cut_scope);
+            pc.restore_checkpoint(base_checkpoint);
+            if (result.is_left_recursion()) {
                 return result;
             }
-            catch (...) {
-                pc.set_state(base_state);
-                throw;
-            }
+            return !result;
+        }
+
+        bool analyze(grammar_analysis<ParseContext>& analysis) const override {
+            analysis.analyze(m_parse_node.get());
+            return true;
+        }
+
+        void compile(bytecode_compiler<ParseContext>& compiler) const override {
+            compiler.compile_logical_not(m_parse_node.get());
+        }
+
+        parse_node_ptr<ParseContext> optimize(grammar_optimizer<ParseContext>& optimizer) override {
+            m_parse_node = optimizer.optimize(m_parse_node);
+            return {};
         }
 
     private:
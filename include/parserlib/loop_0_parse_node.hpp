@@ -16,23 +16,39 @@ namespace parserlib {
         {
         }
 
-        bool parse(ParseContext& pc) const override {
+        const parse_node_ptr<ParseContext>& get_parse_node() const {
+            return m_parse_node;
+        }
+
+        parse_result parse(ParseContext& pc) const override {
             for(;;) {
-                const auto base_state = pc.get_state();
-                try {
-                    if (!m_parse_node->parse(pc) || pc.get_iterator() == base_state.get_iterator()) {
-                        pc.set_state(base_state);
-                        break;
+                const auto base_checkpoint = pc.get_checkpoint();
+                const parse_result result = m_parse_node->parse(pc);
+                if (!result || pc.get_iterator() == base_checkpoint.get_iterator()) {
+                    const bool restored = pc.restore_checkpoint(base_checkpoint);
+                    if (result.is_left_recursion() || (!result && !restored)) {
+                        return result;
                     }
-                }
-                catch (...) {
-                    pc.set_state(base_state);
-                    throw;
+                    break;
                 }
             }
             return true;
         }
 
+        bool analyze(grammar_analysis<ParseContext>& analysis) const override {
+            analysis.analyze(m_parse_node.get());
+            return true;
+        }
+
+        void compile(bytecode_compiler<ParseContext>& compiler) const override {
+            compiler.compile_loop_0(m_parse_node.get());
+        }
+
+        parse_node_ptr<ParseContext> optimize(grammar_optimizer<ParseContext>& optimizer) override {
+            m_parse_node = optimizer.optimize(m_parse_node);
+            return optimizer.optimize_loop_0(m_parse_node);
+        }
+
     private:
         parse_node_ptr<ParseContext> m_parse_node;
     };
@@ -17,23 +17,31 @@ namespace parserlib {
         {
         }
 
-        bool parse(ParseContext& pc) const override {
-            const auto base_state = pc.get_state();
+        parse_result parse(ParseContext& pc) const override {
+            const auto base_checkpoint = pc.get_checkpoint();
             for (size_t count = 0; count < m_times; ++count) {
-                try {
-                    if (!m_parse_node->parse(pc)) {
-                        pc.set_state(base_state);
-                        return false;
-                    }
-                }
-                catch (...) {
-                    pc.set_state(base_state);
-                    throw;
+                const parse_result result = m_parse_node->parse(pc);
+                if (!result) {
+                    pc.restore_checkpoint(base_checkpoint);
+                    return result;
                 }
             }
             return true;
         }
 
+        bool analyze(grammar_analysis<ParseContext>& analysis) const override {
+            return analysis.analyze(m_parse_node.get()) || m_times == 0;
+        }
+
+        void compile(bytecode_compiler<ParseContext>& compiler) const override {
+            compiler.compile_loop_n(m_parse_node.get(), m_times);
+        }
+
+        parse_node_ptr<ParseContext> optimize(grammar_optimizer<ParseContext>& optimizer) override {
+            m_parse_node = optimizer.optimize(m_parse_node);
+            return {};
+        }
+
     private:
         parse_node_ptr<ParseContext> m_parse_node;
         size_t m_times;
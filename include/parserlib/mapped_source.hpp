@@ -0,0 +1,181 @@
+#ifndef PARSERLIB_MAPPED_SOURCE_HPP
+#define PARSERLIB_MAPPED_SOURCE_HPP
+
+
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <utility>
+#include <cstddef>
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <cerrno>
+#endif
+
+
+namespace parserlib {
+
+
+    class mapped_source {
+    public:
+        using value_type = char;
+        using const_iterator = const char*;
+        using iterator = const_iterator;
+
+        mapped_source() {
+        }
+
+        explicit mapped_source(const char* filename) {
+            open(filename);
+        }
+
+        explicit mapped_source(const std::string& filename) {
+            open(filename.c_str());
+        }
+
+        mapped_source(const mapped_source&) = delete;
+
+        mapped_source(mapped_source&& source) noexcept
+            : m_data(std::exchange(source.m_data, nullptr))
+            , m_size(std::exchange(source.m_size, 0))
+        {
+        }
+
+        ~mapped_source() {
+            close();
+        }
+
+        mapped_source& operator = (const mapped_source&) = delete;
+
+        mapped_source& operator = (mapped_source&& source) noexcept {
+            if (this != &source) {
+                close();
+                m_data = std::exchange(source.m_data, nullptr);
+                m_size = std::exchange(source.m_size, 0);
+            }
+            return *this;
+        }
+
+        void open(const char* filename) {
+            close();
+#ifdef _WIN32
+            const HANDLE file = CreateFileA(filename, GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+            if (file == INVALID_HANDLE_VALUE) {
+                throw_last_error("mapped_source: cannot open file");
+            }
+            LARGE_INTEGER size;
+            if (!GetFileSizeEx(file, &size)) {
+                CloseHandle(file);
+                throw_last_error("mapped_source: cannot get file size");
+            }
+            if (size.QuadPart > 0) {
+                const HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+                CloseHandle(file);
+                if (!mapping) {
+                    throw_last_error("mapped_source: cannot map file");
+                }
+                const void* data = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+                CloseHandle(mapping);
+                if (!data) {
+                    throw_last_error("mapped_source: cannot map file");
+                }
+                m_data = static_cast<const char*>(data);
+                m_size = static_cast<size_t>(size.QuadPart);
+            }
+            else {
+                CloseHandle(file);
+            }
+#else
+            const int file = ::open(filename, O_RDONLY);
+            if (file < 0) {
+                throw_last_error("mapped_source: cannot open file");
+            }
+            struct stat status;
+            if (fstat(file, &status) != 0) {
+                const int error = errno;
+                ::close(file);
+                throw std::system_error(error, std::generic_category(), "mapped_source: cannot get file size");
+            }
+            if (status.st_size > 0) {
+                void* data = mmap(nullptr, static_cast<size_t>(status.st_size), PROT_READ, MAP_PRIVATE, file, 0);
+                const int error = errno;
+                ::close(file);
+                if (data == MAP_FAILED) {
+                    throw std::system_error(error, std::generic_category(), "mapped_source: cannot map file");
+                }
+                posix_madvise(data, static_cast<size_t>(status.st_size), POSIX_MADV_SEQUENTIAL);
+                m_data = static_cast<const char*>(data);
+                m_size = static_cast<size_t>(status.st_size);
+            }
+            else {
+                ::close(file);
+            }
+#endif
+        }
+
+        void open(const std::string& filename) {
+            open(filename.c_str());
+        }
+
+        void close() {
+            if (m_data) {
+#ifdef _WIN32
+                UnmapViewOfFile(m_data);
+#else
+                munmap(const_cast<char*>(m_data), m_size);
+#endif
+            }
+            m_data = nullptr;
+            m_size = 0;
+        }
+
+        const char* data() const {
+            return m_data;
+        }
+
+        size_t size() const {
+            return m_size;
+        }
+
+        bool empty() const {
+            return m_size == 0;
+        }
+
+        const_iterator begin() const {
+            return m_data;
+        }
+
+        const_iterator end() const {
+            return m_data + m_size;
+        }
+
+        std::string_view get_view() const {
+            return std::string_view(m_data, m_size);
+        }
+
+    private:
+        const char* m_data{ nullptr };
+        size_t m_size{ 0 };
+
+        [[noreturn]] static void throw_last_error(const char* message) {
+#ifdef _WIN32
+            throw std::system_error(static_cast<int>(GetLastError()), std::system_category(), message);
+#else
+            throw std::system_error(errno, std::generic_category(), message);
+#endif
+        }
+    };
+
+
+} //namespace parserlib
+
+
+#endif //PARSERLIB_MAPPED_SOURCE_HPP
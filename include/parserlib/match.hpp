@@ -3,18 +3,135 @@
 
 
 #include <vector>
+#include <memory>
+#include <cstddef>
 #include "source_partition.hpp"
+#include "numeric_value.hpp"
 
 
 namespace parserlib {
 
 
+    template <class Iterator, class MatchId, class ErrorId, class SymbolComparator>
+    class parse_context;
+
+
+    template <class Iterator, class Id>
+    class match_record {
+    public:
+        static constexpr size_t npos = static_cast<size_t>(-1);
+
+        match_record(const Id& id = {}, const Iterator& begin = {}, const Iterator& end = {}, size_t first_child = npos, size_t prev_sibling = npos, size_t child_count = 0)
+            : m_id(id)
+            , m_begin(begin)
+            , m_end(end)
+            , m_first_child(first_child)
+            , m_next_sibling(npos)
+            , m_prev_sibling(prev_sibling)
+            , m_child_count(child_count)
+        {
+        }
+
+        const Id& get_id() const {
+            return m_id;
+        }
+
+        const Iterator& begin() const {
+            return m_begin;
+        }
+
+        const Iterator& end() const {
+            return m_end;
+        }
+
+        size_t get_first_child() const {
+            return m_first_child;
+        }
+
+        size_t get_next_sibling() const {
+            return m_next_sibling;
+        }
+
+        size_t get_prev_sibling() const {
+            return m_prev_sibling;
+        }
+
+        size_t get_child_count() const {
+            return m_child_count;
+        }
+
+        const numeric_value& get_value() const {
+            return m_value;
+        }
+
+    private:
+        Id m_id;
+        Iterator m_begin;
+        Iterator m_end;
+        size_t m_first_child;
+        size_t m_next_sibling;
+        size_t m_prev_sibling;
+        size_t m_child_count;
+        numeric_value m_value;
+
+        template <class Iterator1, class MatchId, class ErrorId, class SymbolComparator>
+        friend class parse_context;
+    };
+
+
+    template <class Iterator, class Id>
+    using match_record_container = std::vector<match_record<Iterator, Id>>;
+
+
+    template <class Iterator, class Id>
+    class match_tree {
+    public:
+        using match_record_type = match_record<Iterator, Id>;
+        using match_record_container_type = match_record_container<Iterator, Id>;
+
+        match_tree(const match_record_container_type& records)
+            : m_records(records)
+            , m_child_offsets(records.size() + 1, 0)
+        {
+            for (size_t index = 0; index < m_records.size(); ++index) {
+                m_child_offsets[index] = m_children.size();
+                size_t child_index = m_records[index].get_first_child();
+                for (size_t count = m_records[index].get_child_count(); count > 0; --count) {
+                    m_children.push_back(child_index);
+                    child_index = m_records[child_index].get_next_sibling();
+                }
+            }
+            m_child_offsets[m_records.size()] = m_children.size();
+        }
+
+        const match_record_container_type& get_records() const {
+            return m_records;
+        }
+
+        const size_t* get_children(size_t index) const {
+            return m_children.data() + m_child_offsets[index];
+        }
+
+    private:
+        match_record_container_type m_records;
+        std::vector<size_t> m_children;
+        std::vector<size_t> m_child_offsets;
+    };
+
+
     template <class Iterator, class Id>
     class match : public source_partition<Iterator, Id> {
     public:
-        match(const Id& id = {}, const Iterator& begin = {}, const Iterator& end = {}, std::vector<match>&& children = {})
-            : source_partition<Iterator, Id>(id, begin, end)
-            , m_children(std::move(children))
+        using match_record_type = match_record<Iterator, Id>;
+        using match_tree_type = match_tree<Iterator, Id>;
+
+        match() {
+        }
+
+        match(const std::shared_ptr<const match_tree_type>& tree, size_t index)
+            : source_partition<Iterator, Id>(tree->get_records()[index].get_id(), tree->get_records()[index].begin(), tree->get_records()[index].end())
+            , m_tree(tree)
+            , m_index(index)
         {
         }
 
@@ -22,12 +139,37 @@ namespace parserlib {
             return static_cast<int>(this->get_id());
         }
 
+        size_t get_index() const {
+            return m_index;
+        }
+
+        const numeric_value& get_value() const {
+            static const numeric_value empty_value;
+            return m_tree ? m_tree->get_records()[m_index].get_value() : empty_value;
+        }
+
         const std::vector<match>& get_children() const {
-            return m_children;
+            static const std::vector<match> empty_children;
+            if (!m_tree || m_tree->get_records()[m_index].get_child_count() == 0) {
+                return empty_children;
+            }
+            if (!m_children) {
+                const size_t* child_indexes = m_tree->get_children(m_index);
+                const size_t child_count = m_tree->get_records()[m_index].get_child_count();
+                auto children = std::make_shared<std::vector<match>>();
+                children->reserve(child_count);
+                for (size_t index = 0; index < child_count; ++index) {
+                    children->push_back(match(m_tree, child_indexes[index]));
+                }
+                m_children = std::move(children);
+            }
+            return *m_children;
         }
 
     private:
-        std::vector<match> m_children;
+        std::shared_ptr<const match_tree_type> m_tree;
+        size_t m_index{ match_record_type::npos };
+        mutable std::shared_ptr<const std::vector<match>> m_children;
     };
 
 
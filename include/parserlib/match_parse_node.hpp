@@ -19,13 +19,36 @@ namespace parserlib {
         {
         }
 
-        bool parse(ParseContext& pc) const override {
+        const parse_node_ptr<ParseContext>& get_parse_node() const {
+            return m_parse_node;
+        }
+
+        const id_type& get_id() const {
+            return m_id;
+        }
+
+        parse_result parse(ParseContext& pc) const override {
             const auto from_state = pc.get_match_parse_state();
-            if (m_parse_node->parse(pc)) {
+            const size_t partition = pc.open_partition(from_state.get_iterator());
+            const parse_result result = m_parse_node->parse(pc);
+            pc.close_partition(partition);
+            if (result) {
                 pc.add_match(m_id, from_state);
-                return true;
             }
-            return false;
+            return result;
+        }
+
+        bool analyze(grammar_analysis<ParseContext>& analysis) const override {
+            return analysis.analyze(m_parse_node.get());
+        }
+
+        void compile(bytecode_compiler<ParseContext>& compiler) const override {
+            compiler.compile_match(m_parse_node.get(), m_id);
+        }
+
+        parse_node_ptr<ParseContext> optimize(grammar_optimizer<ParseContext>& optimizer) override {
+            m_parse_node = optimizer.optimize(m_parse_node);
+            return {};
         }
 
     private:
@@ -16,12 +16,25 @@ namespace parserlib {
         {
         }
 
-        bool parse(ParseContext& pc) const override {
-            if (m_parse_node->parse(pc)) {
+        parse_result parse(ParseContext& pc) const override {
+            const parse_result result = m_parse_node->parse(pc);
+            if (result) {
                 pc.increment_line();
-                return true;
             }
-            return false;
+            return result;
+        }
+
+        bool analyze(grammar_analysis<ParseContext>& analysis) const override {
+            return analysis.analyze(m_parse_node.get());
+        }
+
+        void compile(bytecode_compiler<ParseContext>& compiler) const override {
+            compiler.compile_newline(m_parse_node.get());
+        }
+
+        parse_node_ptr<ParseContext> optimize(grammar_optimizer<ParseContext>& optimizer) override {
+            m_parse_node = optimizer.optimize(m_parse_node);
+            return {};
         }
 
     private:
@@ -0,0 +1,253 @@
+#ifndef PARSERLIB_NUMBER_SCANNER_HPP
+#define PARSERLIB_NUMBER_SCANNER_HPP
+
+
+#include <array>
+#include <string>
+#include <cstdint>
+#include <limits>
+#include <sstream>
+#include <locale>
+#include <charconv>
+#include <system_error>
+#include <iterator>
+#include "contiguous_iterator.hpp"
+#include "numeric_value.hpp"
+
+
+namespace parserlib {
+
+
+    enum class number_sign {
+        none,
+        minus,
+        plus_minus
+    };
+
+
+    template <class Iterator, bool Padded = false>
+    class number_scanner {
+    public:
+        number_scanner(const Iterator& begin, const Iterator& end)
+            : m_iterator(begin)
+            , m_end(end)
+        {
+        }
+
+        size_t get_count() const {
+            return m_count;
+        }
+
+        const numeric_value& get_value() const {
+            return m_value;
+        }
+
+        bool scan_integer(number_sign sign) {
+            const bool negative = scan_sign(sign);
+            std::uint64_t magnitude = 0;
+            bool overflow = false;
+            const size_t digit_count = scan_digits([&](unsigned digit) {
+                if (magnitude > (std::numeric_limits<std::uint64_t>::max() - digit) / 10) {
+                    overflow = true;
+                }
+                magnitude = magnitude * 10 + digit;
+            });
+            if (digit_count == 0) {
+                return false;
+            }
+            const std::uint64_t limit = static_cast<std::uint64_t>(std::numeric_limits<std::int64_t>::max()) + (negative ? 1 : 0);
+            if (!overflow && magnitude <= limit) {
+                m_value = negative ? static_cast<std::int64_t>(0 - magnitude) : static_cast<std::int64_t>(magnitude);
+            }
+            return true;
+        }
+
+        bool scan_decimal(number_sign sign) {
+            const size_t begin_count = m_count;
+            const Iterator begin = m_iterator;
+            const bool negative = scan_sign(sign);
+            const size_t sign_count = m_count - begin_count;
+
+            std::uint64_t mantissa = 0;
+            int digit_count = 0;
+            long long exponent = 0;
+            bool truncated = false;
+            const auto add_digit = [&](unsigned digit, int fraction) {
+                if (digit_count < max_mantissa_digits) {
+                    mantissa = mantissa * 10 + digit;
+                    if (mantissa > 0) {
+                        ++digit_count;
+                    }
+                    exponent -= fraction;
+                }
+                else {
+                    exponent += 1 - fraction;
+                    truncated = truncated || digit > 0;
+                }
+            };
+
+            if (scan_digits([&](unsigned digit) { add_digit(digit, 0); }) == 0) {
+                return false;
+            }
+
+            number_scanner fraction = *this;
+            if (fraction.accept('.') && fraction.scan_digits([&](unsigned digit) { add_digit(digit, 1); }) > 0) {
+                *this = fraction;
+            }
+
+            number_scanner exponent_part = *this;
+            if (exponent_part.accept('e') || exponent_part.accept('E')) {
+                const bool negative_exponent = exponent_part.scan_sign(number_sign::plus_minus);
+                long long value = 0;
+                if (exponent_part.scan_digits([&](unsigned digit) { value = value < max_exponent ? value * 10 + digit : value; }) > 0) {
+                    *this = exponent_part;
+                    exponent += negative_exponent ? -value : value;
+                }
+            }
+
+            double result;
+            if (!truncated && mantissa <= max_exact_mantissa && exponent >= -max_exact_exponent && exponent <= max_exact_exponent) {
+                result = static_cast<double>(mantissa);
+                result = exponent < 0 ? result / get_power_of_10(-exponent) : result * get_power_of_10(exponent);
+            }
+            else {
+                Iterator it = begin;
+                std::advance(it, sign_count);
+                std::string text;
+                for (size_t index = begin_count + sign_count; index < m_count; ++index, ++it) {
+                    text += static_cast<char>(*it);
+                }
+                result = to_double(text, exponent + digit_count > 0);
+            }
+            m_value = negative ? -result : result;
+            return true;
+        }
+
+    private:
+        static constexpr int max_mantissa_digits = 19;
+        static constexpr std::uint64_t max_exact_mantissa = std::uint64_t(1) << 53;
+        static constexpr long long max_exact_exponent = 22;
+        static constexpr long long max_exponent = 100000;
+
+        Iterator m_iterator;
+        Iterator m_end;
+        size_t m_count{ 0 };
+        numeric_value m_value;
+
+        static double get_power_of_10(long long exponent) {
+            static constexpr std::array<double, 23> powers = {
+                1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+                1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+            };
+            return powers[static_cast<size_t>(exponent)];
+        }
+
+        static double to_double(const std::string& text, bool large) {
+            double result = 0;
+#ifdef __cpp_lib_to_chars
+            if (std::from_chars(text.data(), text.data() + text.size(), result).ec == std::errc::result_out_of_range) {
+                result = large ? std::numeric_limits<double>::infinity() : 0.0;
+            }
+#else
+            std::istringstream stream(text);
+            stream.imbue(std::locale::classic());
+            stream >> result;
+            if (stream.fail()) {
+                result = large ? std::numeric_limits<double>::infinity() : 0.0;
+            }
+#endif
+            return result;
+        }
+
+        bool accept(int symbol) {
+            if ((Padded || m_iterator != m_end) && static_cast<long long>(*m_iterator) == symbol) {
+                ++m_iterator;
+                ++m_count;
+                return true;
+            }
+            return false;
+        }
+
+        bool scan_sign(number_sign sign) {
+            if (sign == number_sign::none) {
+                return false;
+            }
+            if (accept('-')) {
+                return true;
+            }
+            if (sign == number_sign::plus_minus) {
+                accept('+');
+            }
+            return false;
+        }
+
+        template <class F>
+        size_t scan_digits(const F& func) {
+            size_t count = 0;
+            for (; Padded || m_iterator != m_end; ++m_iterator, ++count) {
+                const unsigned long long digit = static_cast<unsigned long long>(static_cast<long long>(*m_iterator) - '0');
+                if (digit > 9) {
+                    break;
+                }
+                func(static_cast<unsigned>(digit));
+            }
+            m_count += count;
+            return count;
+        }
+    };
+
+
+    template <class ParseContext, class F>
+    bool scan_number(ParseContext& pc, const F& scan) {
+        using iterator_type = typename ParseContext::iterator_type;
+        const iterator_type begin = pc.get_iterator();
+        size_t count;
+        numeric_value value;
+        if constexpr (is_padded_iterator_v<iterator_type>) {
+            const size_t size = static_cast<size_t>(pc.get_end_iterator() - begin);
+            const auto* data = get_iterator_address(begin);
+            number_scanner<decltype(data), true> scanner(data, data + size);
+            const bool scanned = scan(scanner);
+            if (scanner.get_count() <= size) {
+                if (!scanned) {
+                    return false;
+                }
+                count = scanner.get_count();
+                value = scanner.get_value();
+            }
+            else {
+                number_scanner<decltype(data)> bounded_scanner(data, data + size);
+                if (!scan(bounded_scanner)) {
+                    return false;
+                }
+                count = bounded_scanner.get_count();
+                value = bounded_scanner.get_value();
+            }
+        }
+        else if constexpr (is_contiguous_iterator_v<iterator_type>) {
+            const auto* data = begin != pc.get_end_iterator() ? get_iterator_address(begin) : nullptr;
+            number_scanner<decltype(data)> scanner(data, data + (pc.get_end_iterator() - begin));
+            if (!scan(scanner)) {
+                return false;
+            }
+            count = scanner.get_count();
+            value = scanner.get_value();
+        }
+        else {
+            number_scanner<iterator_type> scanner(begin, pc.get_end_iterator());
+            if (!scan(scanner)) {
+                return false;
+            }
+            count = scanner.get_count();
+            value = scanner.get_value();
+        }
+        pc.increment_iterator(count);
+        pc.set_numeric_value(begin, value);
+        return true;
+    }
+
+
+} //namespace parserlib
+
+
+#endif //PARSERLIB_NUMBER_SCANNER_HPP
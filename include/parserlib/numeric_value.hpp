@@ -0,0 +1,78 @@
+#ifndef PARSERLIB_NUMERIC_VALUE_HPP
+#define PARSERLIB_NUMERIC_VALUE_HPP
+
+
+#include <cstdint>
+#include <cmath>
+#include <limits>
+
+
+namespace parserlib {
+
+
+    enum class numeric_value_kind {
+        none,
+        integer,
+        decimal
+    };
+
+
+    class numeric_value {
+    public:
+        numeric_value() {
+        }
+
+        numeric_value(std::int64_t value)
+            : m_kind(numeric_value_kind::integer)
+            , m_integer(value)
+        {
+        }
+
+        numeric_value(double value)
+            : m_kind(numeric_value_kind::decimal)
+            , m_decimal(value)
+        {
+        }
+
+        numeric_value_kind get_kind() const {
+            return m_kind;
+        }
+
+        bool empty() const {
+            return m_kind == numeric_value_kind::none;
+        }
+
+        std::int64_t get_integer() const {
+            return m_kind == numeric_value_kind::integer ? m_integer : m_kind == numeric_value_kind::decimal ? decimal_to_integer(m_decimal) : 0;
+        }
+
+        double get_decimal() const {
+            return m_kind == numeric_value_kind::decimal ? m_decimal : m_kind == numeric_value_kind::integer ? static_cast<double>(m_integer) : 0.0;
+        }
+
+    private:
+        numeric_value_kind m_kind{ numeric_value_kind::none };
+        union {
+            std::int64_t m_integer;
+            double m_decimal;
+        };
+
+        static std::int64_t decimal_to_integer(double value) {
+            if (std::isnan(value)) {
+                return 0;
+            }
+            if (value >= 9223372036854775808.0) {
+                return std::numeric_limits<std::int64_t>::max();
+            }
+            if (value < -9223372036854775808.0) {
+                return std::numeric_limits<std::int64_t>::min();
+            }
+            return static_cast<std::int64_t>(value);
+        }
+    };
+
+
+} //namespace parserlib
+
+
+#endif //PARSERLIB_NUMERIC_VALUE_HPP
@@ -0,0 +1,189 @@
+#ifndef PARSERLIB_ONE_OF_PARSE_NODE_HPP
+#define PARSERLIB_ONE_OF_PARSE_NODE_HPP
+
+
+#include <vector>
+#include <map>
+#include <algorithm>
+#include <cstdint>
+#include <type_traits>
+#include "parse_node_ptr.hpp"
+#include "parse_context.hpp"
+
+
+namespace parserlib {
+
+
+    enum class one_of_match {
+        first,
+        longest
+    };
+
+
+    template <class ParseContext>
+    class one_of_parse_node : public parse_node<ParseContext> {
+    public:
+        static constexpr size_t npos = static_cast<size_t>(-1);
+
+        static constexpr bool is_keyed_comparator = is_keyed_symbol_comparator_v<typename ParseContext::symbol_comparator_type>;
+
+        one_of_parse_node(const std::vector<std::vector<int>>& strings, one_of_match match = one_of_match::first)
+            : m_strings(strings)
+            , m_match(match)
+        {
+            if constexpr (is_keyed_comparator) {
+                build_trie();
+            }
+        }
+
+        const std::vector<std::vector<int>>& get_strings() const {
+            return m_strings;
+        }
+
+        one_of_match get_match() const {
+            return m_match;
+        }
+
+        parse_result parse(ParseContext& pc) const override {
+            size_t string_index = npos;
+            size_t length = 0;
+            if constexpr (is_keyed_comparator) {
+                find_in_trie(pc, string_index, length);
+            }
+            else {
+                find_in_strings(pc, string_index, length);
+            }
+            if (string_index == npos) {
+                return false;
+            }
+            pc.increment_iterator(length);
+            return true;
+        }
+
+        bool analyze(grammar_analysis<ParseContext>& analysis) const override {
+            bool nullable = false;
+            for (const std::vector<int>& string : m_strings) {
+                if (string.empty()) {
+                    nullable = true;
+                }
+                else {
+                    analysis.analyze_symbol(string.front());
+                }
+            }
+            return nullable;
+        }
+
+    private:
+        struct trie_node {
+            std::uint32_t m_first_edge{ 0 };
+            std::uint32_t m_edge_count{ 0 };
+            size_t m_string_index{ npos };
+            size_t m_min_string_index{ npos };
+        };
+
+        std::vector<std::vector<int>> m_strings;
+        one_of_match m_match;
+        std::vector<trie_node> m_nodes;
+        std::vector<int> m_edge_keys;
+        std::vector<std::uint32_t> m_edge_nodes;
+
+        template <class Symbol>
+        static int get_key(const Symbol& symbol) {
+            return get_symbol_key<typename ParseContext::symbol_comparator_type>(symbol);
+        }
+
+        void build_trie() {
+            std::vector<std::map<int, size_t>> children(1);
+            std::vector<size_t> string_indexes(1, npos);
+
+            for (size_t string_index = 0; string_index < m_strings.size(); ++string_index) {
+                size_t node = 0;
+                for (const int symbol : m_strings[string_index]) {
+                    const int key = get_key(symbol);
+                    auto it = children[node].find(key);
+                    if (it == children[node].end()) {
+                        it = children[node].emplace(key, children.size()).first;
+                        children.emplace_back();
+                        string_indexes.push_back(npos);
+                    }
+                    node = it->second;
+                }
+                if (string_indexes[node] == npos) {
+                    string_indexes[node] = string_index;
+                }
+            }
+
+            m_nodes.resize(children.size());
+            for (size_t node = 0; node < children.size(); ++node) {
+                m_nodes[node].m_first_edge = static_cast<std::uint32_t>(m_edge_keys.size());
+                m_nodes[node].m_edge_count = static_cast<std::uint32_t>(children[node].size());
+                m_nodes[node].m_string_index = string_indexes[node];
+                for (const auto& [key, child] : children[node]) {
+                    m_edge_keys.push_back(key);
+                    m_edge_nodes.push_back(static_cast<std::uint32_t>(child));
+                }
+            }
+
+            for (size_t node = m_nodes.size(); node-- > 0;) {
+                size_t min_string_index = m_nodes[node].m_string_index;
+                for (std::uint32_t edge = 0; edge < m_nodes[node].m_edge_count; ++edge) {
+                    min_string_index = std::min(min_string_index, m_nodes[m_edge_nodes[m_nodes[node].m_first_edge + edge]].m_min_string_index);
+                }
+                m_nodes[node].m_min_string_index = min_string_index;
+            }
+        }
+
+        void find_in_trie(ParseContext& pc, size_t& string_index, size_t& length) const {
+            size_t node = 0;
+            size_t depth = 0;
+            string_index = m_nodes[0].m_string_index;
+            length = 0;
+            for (auto it = pc.get_iterator(); it != pc.get_end_iterator(); ++it) {
+                if (m_match == one_of_match::first && m_nodes[node].m_min_string_index >= string_index) {
+                    break;
+                }
+                const auto keys_begin = m_edge_keys.begin() + m_nodes[node].m_first_edge;
+                const auto keys_end = keys_begin + m_nodes[node].m_edge_count;
+                const int key = get_key(*it);
+                const auto key_it = std::lower_bound(keys_begin, keys_end, key);
+                if (key_it == keys_end || *key_it != key) {
+                    break;
+                }
+                node = m_edge_nodes[key_it - m_edge_keys.begin()];
+                ++depth;
+                const size_t node_string_index = m_nodes[node].m_string_index;
+                if (node_string_index != npos && (m_match == one_of_match::longest || node_string_index < string_index)) {
+                    string_index = node_string_index;
+                    length = depth;
+                }
+            }
+        }
+
+        void find_in_strings(ParseContext& pc, size_t& string_index, size_t& length) const {
+            string_index = npos;
+            length = 0;
+            for (size_t index = 0; index < m_strings.size(); ++index) {
+                const std::vector<int>& string = m_strings[index];
+                if (string_index != npos && (m_match == one_of_match::first || string.size() <= length)) {
+                    continue;
+                }
+                auto it = pc.get_iterator();
+                size_t symbol_index = 0;
+                for (; symbol_index < string.size(); ++symbol_index, ++it) {
+                    if (it == pc.get_end_iterator() || pc.compare(*it, string[symbol_index]) != 0) {
+                        break;
+                    }
+                }
+                if (symbol_index == string.size()) {
+                    string_index = index;
+                    length = string.size();
+                }
+            }
+        }
+    };
+
+
+} //namespace parserlib
+
+
+#endif //PARSERLIB_ONE_OF_PARSE_NODE_HPP
@@ -16,20 +16,35 @@ namespace parserlib {
         {
         }
 
-        bool parse(ParseContext& pc) const override {
-            const auto base_state = pc.get_state();
-            try {
-                if (!m_parse_node->parse(pc)) {
-                    pc.set_state(base_state);
+        const parse_node_ptr<ParseContext>& get_parse_node() const {
+            return m_parse_node;
+        }
+
+        parse_result parse(ParseContext& pc) const override {
+            const auto base_checkpoint = pc.get_checkpoint();
+            const parse_result result = m_parse_node->parse(pc);
+            if (!result) {
+                if (!pc.restore_checkpoint(base_checkpoint) || result.is_left_recursion()) {
+                    return result;
                 }
             }
-            catch (...) {
-                pc.set_state(base_state);
-                throw;
-            }
             return true;
         }
 
+        bool analyze(grammar_analysis<ParseContext>& analysis) const override {
+            analysis.analyze(m_parse_node.get());
+            return true;
+        }
+
+        void compile(bytecode_compiler<ParseContext>& compiler) const override {
+            compiler.compile_optional(m_parse_node.get());
+        }
+
+        parse_node_ptr<ParseContext> optimize(grammar_optimizer<ParseContext>& optimizer) override {
+            m_parse_node = optimizer.optimize(m_parse_node);
+            return optimizer.optimize_optional(m_parse_node);
+        }
+
     private:
         parse_node_ptr<ParseContext> m_parse_node;
     };
@@ -0,0 +1,220 @@
+#ifndef PARSERLIB_PADDED_SOURCE_HPP
+#define PARSERLIB_PADDED_SOURCE_HPP
+
+
+#include <memory>
+#include <string>
+#include <string_view>
+#include <iterator>
+#include <algorithm>
+#include <type_traits>
+#include <cstring>
+#include <cstddef>
+#include "contiguous_iterator.hpp"
+
+
+namespace parserlib {
+
+
+    class padded_source {
+    public:
+        using value_type = char;
+
+        static constexpr size_t padding = padding_size;
+
+        class const_iterator {
+        public:
+            using iterator_category = std::random_access_iterator_tag;
+            using value_type = char;
+            using difference_type = std::ptrdiff_t;
+            using pointer = const char*;
+            using reference = const char&;
+
+            const_iterator() {
+            }
+
+            reference operator *() const {
+                return *m_pointer;
+            }
+
+            pointer operator ->() const {
+                return m_pointer;
+            }
+
+            reference operator [](difference_type offset) const {
+                return m_pointer[offset];
+            }
+
+            const_iterator& operator ++() {
+                ++m_pointer;
+                return *this;
+            }
+
+            const_iterator operator ++(int) {
+                const_iterator result = *this;
+                ++m_pointer;
+                return result;
+            }
+
+            const_iterator& operator --() {
+                --m_pointer;
+                return *this;
+            }
+
+            const_iterator operator --(int) {
+                const_iterator result = *this;
+                --m_pointer;
+                return result;
+            }
+
+            const_iterator& operator += (difference_type count) {
+                m_pointer += count;
+                return *this;
+            }
+
+            const_iterator& operator -= (difference_type count) {
+                m_pointer -= count;
+                return *this;
+            }
+
+            const_iterator operator + (difference_type count) const {
+                return const_iterator(m_pointer + count);
+            }
+
+            const_iterator operator - (difference_type count) const {
+                return const_iterator(m_pointer - count);
+            }
+
+            difference_type operator - (const const_iterator& it) const {
+                return m_pointer - it.m_pointer;
+            }
+
+            bool operator == (const const_iterator& it) const {
+                return m_pointer == it.m_pointer;
+            }
+
+            bool operator != (const const_iterator& it) const {
+                return m_pointer != it.m_pointer;
+            }
+
+            bool operator < (const const_iterator& it) const {
+                return m_pointer < it.m_pointer;
+            }
+
+            bool operator > (const const_iterator& it) const {
+                return m_pointer > it.m_pointer;
+            }
+
+            bool operator <= (const const_iterator& it) const {
+                return m_pointer <= it.m_pointer;
+            }
+
+            bool operator >= (const const_iterator& it) const {
+                return m_pointer >= it.m_pointer;
+            }
+
+        private:
+            const char* m_pointer{ nullptr };
+
+            const_iterator(const char* pointer)
+                : m_pointer(pointer)
+            {
+            }
+
+            friend class padded_source;
+        };
+
+        using iterator = const_iterator;
+
+        padded_source()
+            : padded_source(std::string_view())
+        {
+        }
+
+        explicit padded_source(std::string_view text)
+            : m_data(std::make_unique<char[]>(text.size() + padding))
+            , m_size(text.size())
+        {
+            if (!text.empty()) {
+                std::memcpy(m_data.get(), text.data(), text.size());
+            }
+        }
+
+        explicit padded_source(const char* text)
+            : padded_source(std::string_view(text))
+        {
+        }
+
+        explicit padded_source(const std::string& text)
+            : padded_source(std::string_view(text))
+        {
+        }
+
+        template <class Iterator>
+        padded_source(Iterator begin, Iterator end)
+            : m_data(std::make_unique<char[]>(static_cast<size_t>(std::distance(begin, end)) + padding))
+            , m_size(static_cast<size_t>(std::distance(begin, end)))
+        {
+            std::copy(begin, end, m_data.get());
+        }
+
+        padded_source(const padded_source& source)
+            : padded_source(source.get_view())
+        {
+        }
+
+        padded_source(padded_source&& source) = default;
+
+        padded_source& operator = (const padded_source& source) {
+            if (this != &source) {
+                *this = padded_source(source);
+            }
+            return *this;
+        }
+
+        padded_source& operator = (padded_source&& source) = default;
+
+        const char* data() const {
+            return m_data.get();
+        }
+
+        size_t size() const {
+            return m_size;
+        }
+
+        bool empty() const {
+            return m_size == 0;
+        }
+
+        const_iterator begin() const {
+            return const_iterator(m_data.get());
+        }
+
+        const_iterator end() const {
+            return const_iterator(m_data.get() + m_size);
+        }
+
+        std::string_view get_view() const {
+            return std::string_view(m_data.get(), m_size);
+        }
+
+    private:
+        std::unique_ptr<char[]> m_data;
+        size_t m_size;
+    };
+
+
+    template <>
+    struct is_contiguous_iterator<padded_source::const_iterator> : std::true_type {
+    };
+
+
+    template <>
+    struct is_padded_iterator<padded_source::const_iterator> : std::true_type {
+    };
+
+
+} //namespace parserlib
+
+
+#endif //PARSERLIB_PADDED_SOURCE_HPP
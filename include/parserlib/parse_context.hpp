@@ -3,10 +3,13 @@
 
 
 #include <string>
-#include <map>
-#include <stdexcept>
+#include <memory>
+#include <unordered_map>
+#include <iterator>
+#include <functional>
 #include <algorithm>
-#include <cctype>
+#include <array>
+#include <type_traits>
 #include "match.hpp"
 #include "error.hpp"
 #include "parse_node.hpp"
@@ -20,6 +23,28 @@ namespace parserlib {
     class parse_context;
 
 
+    template <class Iterator>
+    Iterator make_weak_iterator(const Iterator& it) {
+        return it;
+    }
+
+
+    template <class Iterator>
+    void commit_iterator(const Iterator&) {
+    }
+
+
+    template <class Iterator>
+    bool is_iterator_before(const Iterator& a, const Iterator& b) {
+        if constexpr (std::is_base_of_v<std::random_access_iterator_tag, typename std::iterator_traits<Iterator>::iterator_category>) {
+            return a < b;
+        }
+        else {
+            return false;
+        }
+    }
+
+
     template <class Iterator>
     class parse_state {
     public:
@@ -39,9 +64,15 @@ namespace parserlib {
             return m_match_count;
         }
 
+        size_t get_position() const {
+            return m_position;
+        }
+
     private:
         Iterator m_iterator;
         size_t m_match_count;
+        size_t m_committed_match_count{ 0 };
+        size_t m_position{ 0 };
 
         template <class Iterator1, class MatchId, class ErrorId, class SymbolComparator>
         friend class parse_context;
@@ -92,6 +123,80 @@ namespace parserlib {
     };
 
 
+    template <class Iterator>
+    class numeric_value_state {
+    public:
+        using iterator_type = Iterator;
+
+        const numeric_value& get_value() const {
+            return m_value;
+        }
+
+        const Iterator& begin() const {
+            return m_begin;
+        }
+
+        const Iterator& end() const {
+            return m_end;
+        }
+
+        bool is_set() const {
+            return m_set;
+        }
+
+    private:
+        numeric_value m_value;
+        Iterator m_begin{};
+        Iterator m_end{};
+        bool m_set{ false };
+
+        template <class Iterator1, class MatchId, class ErrorId, class SymbolComparator>
+        friend class parse_context;
+    };
+
+
+    template <class Iterator>
+    class parse_checkpoint {
+    public:
+        using iterator_type = Iterator;
+
+        const Iterator& get_iterator() const {
+            return m_iterator;
+        }
+
+        size_t get_match_count() const {
+            return m_match_count;
+        }
+
+        size_t get_error_count() const {
+            return m_error_count;
+        }
+
+    private:
+        Iterator m_iterator;
+        size_t m_position;
+        size_t m_match_count;
+        size_t m_error_count;
+        size_t m_left_recursion_state_index;
+        size_t m_cut_count;
+        size_t m_numeric_value_count;
+
+        parse_checkpoint(const Iterator& iterator, size_t position, size_t match_count, size_t error_count, size_t left_recursion_state_index, size_t cut_count, size_t numeric_value_count)
+            : m_iterator(iterator)
+            , m_position(position)
+            , m_match_count(match_count)
+            , m_error_count(error_count)
+            , m_left_recursion_state_index(left_recursion_state_index)
+            , m_cut_count(cut_count)
+            , m_numeric_value_count(numeric_value_count)
+        {
+        }
+
+        template <class Iterator1, class MatchId, class ErrorId, class SymbolComparator>
+        friend class parse_context;
+    };
+
+
     template <class Iterator, class MatchId, class ErrorId>
     class parse_context_memoized_state {
     public:
@@ -102,8 +207,8 @@ namespace parserlib {
             return m_state;
         }
 
-        const std::vector<match<Iterator, MatchId>>& get_matches() const {
-            return m_matches;
+        const match_record_container<Iterator, MatchId>& get_match_records() const {
+            return m_match_records;
         }
 
         const std::vector<error<Iterator, ErrorId>>& get_errors() const {
@@ -112,10 +217,38 @@ namespace parserlib {
 
     private:
         parse_context_state<Iterator> m_state;
-        size_t m_base_match_count;
-        size_t m_base_error_count;
-        std::vector<match<Iterator, MatchId>> m_matches;
+        size_t m_base_match_count{ 0 };
+        size_t m_base_error_count{ 0 };
+        match_record_container<Iterator, MatchId> m_match_records;
         std::vector<error<Iterator, ErrorId>> m_errors;
+        numeric_value_state<Iterator> m_numeric_value_state;
+        bool m_numeric_value_changed{ false };
+
+        template <class Iterator1, class MatchId1, class ErrorId1, class SymbolComparator>
+        friend class parse_context;
+    };
+
+
+    template <class Iterator, class MatchId, class ErrorId>
+    class memoized_result {
+    public:
+        memoized_result(bool result = false, const parse_context_memoized_state<Iterator, MatchId, ErrorId>& state = {})
+            : m_result(result)
+            , m_state(state)
+        {
+        }
+
+        bool get_result() const {
+            return m_result;
+        }
+
+        const parse_context_memoized_state<Iterator, MatchId, ErrorId>& get_state() const {
+            return m_state;
+        }
+
+    private:
+        bool m_result;
+        parse_context_memoized_state<Iterator, MatchId, ErrorId> m_state;
 
         template <class Iterator1, class MatchId1, class ErrorId1, class SymbolComparator>
         friend class parse_context;
@@ -157,25 +290,6 @@ namespace parserlib {
     };
 
 
-    template <class ParseContext>
-    class left_recursion_exception {
-    public:
-        using parse_node_type = parse_node<ParseContext>;
-
-        left_recursion_exception(const parse_node_type* parse_node)
-            : m_parse_node(parse_node)
-        {
-        }
-
-        const parse_node_type* get_parse_node() const {
-            return m_parse_node;
-        }
-
-    private:
-        const parse_node_type* m_parse_node;
-    };
-
-
     class default_symbol_comparator {
     public:
         template <class L, class R>
@@ -187,15 +301,60 @@ namespace parserlib {
 
     class case_insensitive_symbol_comparator {
     public:
+        static int fold(int symbol) {
+            return symbol >= 0 && symbol < 128 ? get_table()[symbol] : symbol;
+        }
+
         template <class L, class R>
         static int compare(const L& l, const R& r) {
-            return std::tolower(static_cast<int>(l)) - std::tolower(static_cast<int>(r));
+            return fold(static_cast<int>(l)) - fold(static_cast<int>(r));
+        }
+
+    private:
+        static const std::array<unsigned char, 128>& get_table() {
+            static const std::array<unsigned char, 128> table = []() {
+                std::array<unsigned char, 128> result{};
+                for (int symbol = 0; symbol < 128; ++symbol) {
+                    result[symbol] = static_cast<unsigned char>(symbol >= 'A' && symbol <= 'Z' ? symbol - 'A' + 'a' : symbol);
+                }
+                return result;
+            }();
+            return table;
         }
     };
 
 
+    template <class SymbolComparator, class = void>
+    struct has_symbol_fold : std::false_type {
+    };
+
+
+    template <class SymbolComparator>
+    struct has_symbol_fold<SymbolComparator, std::void_t<decltype(SymbolComparator::fold(0))>> : std::true_type {
+    };
+
+
+    template <class SymbolComparator>
+    inline constexpr bool has_symbol_fold_v = has_symbol_fold<SymbolComparator>::value;
+
+
+    template <class SymbolComparator>
+    inline constexpr bool is_keyed_symbol_comparator_v = std::is_same_v<SymbolComparator, default_symbol_comparator> || has_symbol_fold_v<SymbolComparator>;
+
+
+    template <class SymbolComparator, class Symbol>
+    int get_symbol_key(const Symbol& symbol) {
+        if constexpr (has_symbol_fold_v<SymbolComparator>) {
+            return SymbolComparator::fold(static_cast<int>(symbol));
+        }
+        else {
+            return static_cast<int>(symbol);
+        }
+    }
+
+
     template <class Iterator>
-    void increment_line(Iterator& it) {
+    void increment_line(Iterator&) {
     }
 
 
@@ -209,17 +368,21 @@ namespace parserlib {
 
         using parse_state_type = parse_state<Iterator>;
         using parse_context_state_type = parse_context_state<Iterator>;
+        using parse_checkpoint_type = parse_checkpoint<Iterator>;
 
         using parse_context_memoized_state_type = parse_context_memoized_state<Iterator, MatchId, ErrorId>;
+        using memoized_result_type = memoized_result<Iterator, MatchId, ErrorId>;
 
         using match_type = match<Iterator, MatchId>;
         using match_container_type = std::vector<match_type>;
+        using match_record_type = match_record<Iterator, MatchId>;
+        using match_record_container_type = match_record_container<Iterator, MatchId>;
+        using match_tree_type = match_tree<Iterator, MatchId>;
 
         using error_type = parserlib::error<Iterator, ErrorId>;
         using error_container_type = std::vector<error_type>;
 
         using parse_node_type = parse_node<parse_context>;
-        using left_recursion_exception_type = left_recursion_exception<parse_context>;
 
         template <class DerivedMatchId, class DerivedErrorId, class DerivedSymbolComparator = default_symbol_comparator>
         struct derived_parse_context {
@@ -229,11 +392,14 @@ namespace parserlib {
         template <class DerivedMatchId, class DerivedErrorId, class DerivedSymbolComparator = default_symbol_comparator>
         using derived_parse_context_type = typename derived_parse_context<DerivedMatchId, DerivedErrorId, DerivedSymbolComparator>::type;
 
+        static constexpr size_t npos_rule_index = static_cast<size_t>(-1);
+
         parse_context(const Iterator& begin, const Iterator& end)
             : m_state(begin, end)
-            , m_begin_iterator(begin)
+            , m_begin_iterator(make_weak_iterator(begin))
             , m_end_iterator(end)
         {
+            m_state.m_match_parse_state.m_iterator = m_begin_iterator;
         }
 
         template <class Container>
@@ -242,36 +408,131 @@ namespace parserlib {
         {
         }
 
-        const parse_context_state_type& get_state() const {
-            return m_state;
+        parse_context_state_type get_state() const {
+            parse_context_state_type result = m_state;
+            result.m_match_parse_state = get_match_parse_state();
+            return result;
         }
 
         void set_state(const parse_context_state_type& state) {
             m_state = state;
-            m_matches.resize(state.m_parse_state.m_match_count);
+            m_match_parse_state_lagging = !is_same_parse_state(state.m_match_parse_state, state.m_parse_state);
+            m_iterator_locked = state.m_end_iterator != m_end_iterator;
+            if (m_match_records.size() != state.m_parse_state.m_match_count) {
+                m_match_records.resize(state.m_parse_state.m_match_count);
+                m_matches_valid = false;
+            }
             m_errors.resize(state.m_error_count);
+            invalidate_oldest_indexes();
+        }
+
+        parse_checkpoint_type get_checkpoint() {
+            size_t left_recursion_state_index = left_recursion_checkpoint_state::npos;
+            if (m_match_parse_state_lagging || m_iterator_locked) {
+                left_recursion_state_index = m_left_recursion_checkpoint_states.size();
+                m_left_recursion_checkpoint_states.push_back(left_recursion_checkpoint_state(m_state.m_match_parse_state, m_state.m_end_iterator, m_match_parse_state_lagging, m_iterator_locked));
+            }
+            return parse_checkpoint_type(m_state.m_parse_state.m_iterator, m_state.m_parse_state.m_position, m_state.m_parse_state.m_match_count, m_state.m_error_count, left_recursion_state_index, m_cut_count, m_numeric_value_count);
+        }
+
+        bool restore_checkpoint(const parse_checkpoint_type& checkpoint) {
+            if (checkpoint.m_cut_count != m_cut_count) {
+                return false;
+            }
+            m_state.m_parse_state.m_iterator = checkpoint.m_iterator;
+            m_state.m_parse_state.m_position = checkpoint.m_position;
+            if (m_state.m_parse_state.m_match_count != checkpoint.m_match_count) {
+                m_state.m_parse_state.m_match_count = checkpoint.m_match_count;
+                m_match_records.resize(checkpoint.m_match_count);
+                m_matches_valid = false;
+            }
+            if (m_state.m_error_count != checkpoint.m_error_count) {
+                m_state.m_error_count = checkpoint.m_error_count;
+                m_errors.resize(checkpoint.m_error_count);
+            }
+            invalidate_oldest_indexes();
+            if (m_numeric_value_count != checkpoint.m_numeric_value_count) {
+                m_numeric_value_state.m_set = false;
+            }
+            if (checkpoint.m_left_recursion_state_index != left_recursion_checkpoint_state::npos) {
+                const left_recursion_checkpoint_state& state = m_left_recursion_checkpoint_states[checkpoint.m_left_recursion_state_index];
+                m_state.m_match_parse_state = state.m_match_parse_state;
+                m_state.m_end_iterator = state.m_end_iterator;
+                m_match_parse_state_lagging = state.m_match_parse_state_lagging;
+                m_iterator_locked = state.m_iterator_locked;
+            }
+            else if (m_match_parse_state_lagging || m_iterator_locked) {
+                m_match_parse_state_lagging = false;
+                unlock_iterator();
+            }
+            return true;
         }
 
-        parse_context_memoized_state_type get_memoized_state(const parse_context_state_type& base_state) const {
+        parse_context_memoized_state_type get_memoized_state(const parse_context_state_type& base_state, size_t base_numeric_value_count) const {
             parse_context_memoized_state_type result;
-            result.m_state = m_state;
+            result.m_state = get_state();
             result.m_base_match_count = base_state.m_match_parse_state.m_match_count;
             result.m_base_error_count = base_state.m_error_count;
-            result.m_matches.insert(result.m_matches.end(), m_matches.begin() + base_state.m_match_parse_state.m_match_count, m_matches.end());
+            result.m_match_records.insert(result.m_match_records.end(), m_match_records.begin() + base_state.m_match_parse_state.m_match_count, m_match_records.end());
             result.m_errors.insert(result.m_errors.end(), m_errors.begin() + base_state.m_error_count, m_errors.end());
+            if (m_numeric_value_count != base_numeric_value_count) {
+                result.m_numeric_value_state = m_numeric_value_state;
+                result.m_numeric_value_changed = true;
+            }
             return result;
         }
 
         void set_memoized_state(const parse_context_memoized_state_type& mem_state) {
+            const size_t match_count = m_match_records.size();
+            const size_t error_count = m_errors.size();
             m_state = mem_state.m_state;
-            m_matches.resize(mem_state.m_base_match_count);
-            m_matches.insert(m_matches.end(), mem_state.m_matches.begin(), mem_state.m_matches.end());
-            m_errors.resize(mem_state.m_base_error_count);
-            m_errors.insert(m_errors.end(), mem_state.m_errors.begin(), mem_state.m_errors.end());
+            m_state.m_parse_state.m_match_count = match_count + (mem_state.m_state.m_parse_state.m_match_count - mem_state.m_base_match_count);
+            m_state.m_match_parse_state.m_match_count = match_count + (mem_state.m_state.m_match_parse_state.m_match_count - mem_state.m_base_match_count);
+            m_state.m_error_count = error_count + (mem_state.m_state.m_error_count - mem_state.m_base_error_count);
+            const size_t last_match_index = match_count - 1;
+            for (match_record_type record : mem_state.m_match_records) {
+                record.m_first_child = rebase_match_index(record.m_first_child, mem_state.m_base_match_count, match_count, last_match_index);
+                record.m_next_sibling = rebase_match_index(record.m_next_sibling, mem_state.m_base_match_count, match_count, last_match_index);
+                record.m_prev_sibling = rebase_match_index(record.m_prev_sibling, mem_state.m_base_match_count, match_count, last_match_index);
+                m_match_records.push_back(record);
+                update_oldest_match_index();
+            }
+            m_matches_valid = false;
+            for (const error_type& e : mem_state.m_errors) {
+                m_errors.push_back(e);
+                update_oldest_error_index();
+            }
+            if (mem_state.m_numeric_value_changed) {
+                m_numeric_value_state = mem_state.m_numeric_value_state;
+                ++m_numeric_value_count;
+            }
+            m_match_parse_state_lagging = false;
+        }
+
+        bool is_memoization_enabled() const {
+            return m_memoization_enabled;
+        }
+
+        void set_memoization_enabled(bool enabled) {
+            m_memoization_enabled = enabled;
+        }
+
+        size_t get_memoization_hit_count() const {
+            return m_memoization_hit_count;
+        }
+
+        size_t get_memoization_miss_count() const {
+            return m_memoization_miss_count;
+        }
+
+        void clear_memoized_results() {
+            m_memoized_results.clear();
+            m_memoization_hit_count = 0;
+            m_memoization_miss_count = 0;
         }
 
         const parse_state_type& get_match_parse_state() const {
-            return m_state.m_match_parse_state;
+            return m_match_parse_state_lagging ? m_state.m_match_parse_state : m_state.m_parse_state;
         }
 
         const Iterator& get_iterator() const {
@@ -279,7 +540,7 @@ namespace parserlib {
         }
 
         const Iterator& get_begin_iterator() const {
-            return m_state.m_begin_iterator;
+            return m_begin_iterator;
         }
 
         const Iterator& get_end_iterator() const {
@@ -292,17 +553,19 @@ namespace parserlib {
 
         void increment_iterator() {
             ++m_state.m_parse_state.m_iterator;
-            m_state.m_match_parse_state = m_state.m_parse_state;
+            ++m_state.m_parse_state.m_position;
+            m_match_parse_state_lagging = false;
         }
 
         void increment_iterator(size_t count) {
             m_state.m_parse_state.m_iterator += count;
-            m_state.m_match_parse_state = m_state.m_parse_state;
+            m_state.m_parse_state.m_position += count;
+            m_match_parse_state_lagging = false;
         }
 
         void increment_line() {
             parserlib::increment_line(m_state.m_parse_state.m_iterator);
-            m_state.m_match_parse_state = m_state.m_parse_state;
+            m_match_parse_state_lagging = false;
         }
 
         template <class L, class R>
@@ -311,15 +574,107 @@ namespace parserlib {
         }
 
         const match_container_type& get_matches() const {
+            if (!m_matches_valid) {
+                m_matches.clear();
+                if (!m_match_records.empty()) {
+                    const std::shared_ptr<const match_tree_type> tree = std::make_shared<const match_tree_type>(m_match_records);
+                    for (size_t index = m_match_records.size() - 1; index != match_record_type::npos; index = m_match_records[index].m_prev_sibling) {
+                        m_matches.push_back(match_type(tree, index));
+                    }
+                    std::reverse(m_matches.begin(), m_matches.end());
+                }
+                m_matches_valid = true;
+            }
             return m_matches;
         }
 
+        const match_record_container_type& get_match_records() const {
+            return m_match_records;
+        }
+
         void add_match(const MatchId& id, const parse_state_type& from_state) {
-            match_container_type children(m_matches.begin() + from_state.m_match_count, m_matches.end());
-            m_matches.resize(from_state.m_match_count);
-            m_matches.push_back(match_type(id, from_state.m_iterator, m_state.m_parse_state.m_iterator, std::move(children)));
-            m_state.m_parse_state.m_match_count = m_matches.size();
-            m_state.m_match_parse_state.m_match_count = m_matches.size();
+            const size_t committed_count = m_committed_match_count - from_state.m_committed_match_count;
+            const size_t from_count = from_state.m_match_count > committed_count ? from_state.m_match_count - committed_count : 0;
+            size_t first_child = match_record_type::npos;
+            size_t child_count = 0;
+            size_t index = m_match_records.size() - 1;
+            for (; index != match_record_type::npos && index >= from_count; index = m_match_records[index].m_prev_sibling) {
+                m_match_records[index].m_next_sibling = first_child;
+                first_child = index;
+                ++child_count;
+            }
+            m_match_records.push_back(match_record_type(id, from_state.m_iterator, m_state.m_parse_state.m_iterator, first_child, index, child_count));
+            update_oldest_match_index();
+            if (m_numeric_value_state.m_set && from_state.m_iterator == m_numeric_value_state.m_begin && m_state.m_parse_state.m_iterator == m_numeric_value_state.m_end) {
+                m_match_records.back().m_value = m_numeric_value_state.m_value;
+            }
+            m_state.m_parse_state.m_match_count = m_match_records.size();
+            m_state.m_match_parse_state.m_match_count = m_match_records.size();
+            m_matches_valid = false;
+        }
+
+        void set_numeric_value(const Iterator& begin, const numeric_value& value) {
+            m_numeric_value_state.m_value = value;
+            m_numeric_value_state.m_begin = begin;
+            m_numeric_value_state.m_end = m_state.m_parse_state.m_iterator;
+            m_numeric_value_state.m_set = true;
+            ++m_numeric_value_count;
+        }
+
+        void cut() {
+            ++m_cut_count;
+            if (m_cut_scope_depth > 0) {
+                return;
+            }
+            m_memoized_results.clear();
+            if (m_commit_handler && !m_match_records.empty()) {
+                m_commit_handler(get_matches());
+                m_committed_match_count += m_match_records.size();
+                m_match_records.clear();
+                m_oldest_match_index = npos;
+                m_matches.clear();
+                m_matches_valid = false;
+                m_state.m_parse_state.m_match_count = 0;
+                m_state.m_parse_state.m_committed_match_count = m_committed_match_count;
+                m_state.m_match_parse_state.m_match_count = 0;
+                m_state.m_match_parse_state.m_committed_match_count = m_committed_match_count;
+            }
+            commit_iterator(get_oldest_live_iterator());
+        }
+
+        size_t get_cut_count() const {
+            return m_cut_count;
+        }
+
+        size_t begin_cut_scope() {
+            ++m_cut_scope_depth;
+            return m_cut_count;
+        }
+
+        void end_cut_scope(size_t cut_count) {
+            --m_cut_scope_depth;
+            m_cut_count = cut_count;
+        }
+
+        size_t open_partition(const Iterator& begin) {
+            m_open_partition_iterators.push_back(begin);
+            return m_open_partition_iterators.size() - 1;
+        }
+
+        void close_partition(size_t index) {
+            m_open_partition_iterators.erase(m_open_partition_iterators.begin() + index, m_open_partition_iterators.end());
+        }
+
+        size_t get_open_partition_count() const {
+            return m_open_partition_iterators.size();
+        }
+
+        size_t get_committed_match_count() const {
+            return m_committed_match_count;
+        }
+
+        void set_commit_handler(const std::function<void(const match_container_type&)>& handler) {
+            m_commit_handler = handler;
         }
 
         const error_container_type& get_errors() const {
@@ -328,132 +683,326 @@ namespace parserlib {
 
         void add_error(const ErrorId& id, const Iterator& from_iterator) {
             m_errors.push_back(error_type(id, from_iterator, m_state.m_parse_state.m_iterator));
+            update_oldest_error_index();
             m_state.m_error_count = m_errors.size();
         }
 
-        bool parse_left_recursion(const parse_node_type* parse_node) {
-            auto it = m_left_recursion_states.find(parse_node);
-
-            if (it == m_left_recursion_states.end()) {
-                auto [it, ok] = m_left_recursion_states.insert(std::make_pair(parse_node, left_recursion_state_type(m_state.m_parse_state.m_iterator, left_recursion_status::none)));
+        parse_result parse_left_recursion(const parse_node_type* rule, size_t rule_index, const parse_node_type* parse_node) {
+            left_recursion_slot& slot = get_left_recursion_slot(rule, rule_index);
 
-                try {
-                    return parse_node->parse(*this);
-                }
-
-                catch (const left_recursion_exception_type& ex) {
-                    if (ex.get_parse_node() == parse_node) {
-                        return handle_left_recursion(parse_node, it->second);
-                    }
-                    throw ex;
+            if (!slot.m_rule) {
+                slot = left_recursion_slot(rule, left_recursion_state_type(m_state.m_parse_state.m_iterator, left_recursion_status::none));
+                parse_result result = parse_node->parse(*this);
+                if (is_left_recursion_of(result, rule)) {
+                    result = handle_left_recursion(rule, rule_index, parse_node);
                 }
+                get_left_recursion_slot(rule, rule_index) = left_recursion_slot();
+                return result;
             }
 
-            if (m_state.m_parse_state.m_iterator != it->second.m_iterator) {
-                const left_recursion_state_type prev_left_recursion_state = it->second;
-                it->second = left_recursion_state_type(m_state.m_parse_state.m_iterator, left_recursion_status::none);
-
-                try {
-                    const bool result = parse_node->parse(*this);
-                    it->second = prev_left_recursion_state;
-                    return result;
-                }
-
-                catch (const left_recursion_exception_type& ex) {
-                    it->second = prev_left_recursion_state;
-                    if (ex.get_parse_node() == parse_node) {
-                        return handle_left_recursion(parse_node, it->second);
-                    }
-                    throw ex;
-                }
+            const left_recursion_state_type& left_recursion_state = slot.m_state;
 
-                catch (...) {
-                    it->second = prev_left_recursion_state;
-                    throw;
+            if (m_state.m_parse_state.m_iterator != left_recursion_state.m_iterator) {
+                const left_recursion_state_type prev_left_recursion_state = left_recursion_state;
+                slot.m_state = left_recursion_state_type(m_state.m_parse_state.m_iterator, left_recursion_status::none);
+                const parse_result result = parse_node->parse(*this);
+                get_left_recursion_slot(rule, rule_index).m_state = prev_left_recursion_state;
+                if (is_left_recursion_of(result, rule)) {
+                    return handle_left_recursion(rule, rule_index, parse_node);
                 }
+                return result;
             }
 
-            switch (it->second.m_status) {
-                case left_recursion_status::none:
-                    throw left_recursion_exception_type(parse_node);
-
+            switch (left_recursion_state.m_status) {
                 case left_recursion_status::reject:
                     return false;
 
                 case left_recursion_status::accept:
                     unlock_iterator();
                     return true;
+
+                default:
+                    break;
             }
 
-            throw std::runtime_error("invalid state");
+            m_left_recursion_rule = rule;
+            return parse_result::left_recursion;
+        }
+
+        parse_result parse_memoized(const parse_node_type* rule, size_t rule_index, const parse_node_type* parse_node, bool left_recursive = true) {
+            if (!can_memoize()) {
+                return parse_rule(rule, rule_index, parse_node, left_recursive);
+            }
+
+            const memoized_result_key key(rule, m_state.m_parse_state.m_position);
+            auto it = m_memoized_results.find(key);
+
+            if (it != m_memoized_results.end()) {
+                ++m_memoization_hit_count;
+                if (it->second.m_result) {
+                    set_memoized_state(it->second.m_state);
+                }
+                return it->second.m_result;
+            }
+
+            ++m_memoization_miss_count;
+            const parse_context_state_type base_state = get_state();
+            const size_t base_cut_count = m_cut_count;
+            const size_t base_numeric_value_count = m_numeric_value_count;
+            const parse_result result = parse_rule(rule, rule_index, parse_node, left_recursive);
+
+            if (result.is_left_recursion() || m_cut_count != base_cut_count) {
+                return result;
+            }
+
+            if (!result) {
+                m_memoized_results.emplace(key, memoized_result_type(false));
+            }
+            else if (can_memoize()) {
+                m_memoized_results.emplace(key, memoized_result_type(true, get_memoized_state(base_state, base_numeric_value_count)));
+            }
+
+            return result;
         }
 
         template <class DerivedMatchId = int, class DerivedErrorId = int, class DerivedSymbolComparator = default_symbol_comparator>
         auto derive_parse_context() const {
-            return parse_context<typename match_container_type::const_iterator, DerivedMatchId, DerivedErrorId, DerivedSymbolComparator>(m_matches);
+            return parse_context<typename match_container_type::const_iterator, DerivedMatchId, DerivedErrorId, DerivedSymbolComparator>(get_matches());
         }
 
     private:
         using left_recursion_state_type = left_recursion_state<Iterator>;
-        using left_recursion_state_map = std::map<const parse_node_type*, left_recursion_state_type>;
+        using memoized_result_key = std::pair<const parse_node_type*, size_t>;
+
+        static constexpr size_t npos = static_cast<size_t>(-1);
+
+        struct left_recursion_slot {
+            left_recursion_slot(const parse_node_type* rule = nullptr, const left_recursion_state_type& state = {})
+                : m_rule(rule)
+                , m_state(state)
+            {
+            }
+
+            const parse_node_type* m_rule;
+            left_recursion_state_type m_state;
+        };
+
+        struct left_recursion_checkpoint_state {
+            static constexpr size_t npos = static_cast<size_t>(-1);
+
+            left_recursion_checkpoint_state(const parse_state_type& match_parse_state, const Iterator& end_iterator, bool match_parse_state_lagging, bool iterator_locked)
+                : m_match_parse_state(match_parse_state)
+                , m_end_iterator(end_iterator)
+                , m_match_parse_state_lagging(match_parse_state_lagging)
+                , m_iterator_locked(iterator_locked)
+            {
+            }
+
+            parse_state_type m_match_parse_state;
+            Iterator m_end_iterator;
+            bool m_match_parse_state_lagging;
+            bool m_iterator_locked;
+        };
+
+        struct memoized_result_key_hash {
+            size_t operator ()(const memoized_result_key& key) const {
+                return (reinterpret_cast<size_t>(key.first) * 0x100000001b3ull) ^ (key.second * 0x9e3779b97f4a7c15ull);
+            }
+        };
+
+        using memoized_result_map = std::unordered_map<memoized_result_key, memoized_result_type, memoized_result_key_hash>;
 
         parse_context_state_type m_state;
-        match_container_type m_matches;
+        match_record_container_type m_match_records;
+        mutable match_container_type m_matches;
+        mutable bool m_matches_valid{ false };
         error_container_type m_errors;
-        left_recursion_state_map m_left_recursion_states;
+        std::vector<left_recursion_slot> m_left_recursion_states;
+        std::unordered_map<const parse_node_type*, left_recursion_slot> m_hashed_left_recursion_states;
+        size_t m_left_recursion_depth{ 0 };
+        const parse_node_type* m_left_recursion_rule{ nullptr };
+        std::vector<left_recursion_checkpoint_state> m_left_recursion_checkpoint_states;
+        bool m_match_parse_state_lagging{ false };
+        bool m_iterator_locked{ false };
+        memoized_result_map m_memoized_results;
+        bool m_memoization_enabled{ false };
+        size_t m_memoization_hit_count{ 0 };
+        size_t m_memoization_miss_count{ 0 };
         const Iterator m_begin_iterator;
         const Iterator m_end_iterator;
+        numeric_value_state<Iterator> m_numeric_value_state;
+        size_t m_numeric_value_count{ 0 };
+        size_t m_cut_count{ 0 };
+        size_t m_cut_scope_depth{ 0 };
+        size_t m_committed_match_count{ 0 };
+        size_t m_oldest_match_index{ npos };
+        size_t m_oldest_error_index{ npos };
+        std::vector<Iterator> m_open_partition_iterators;
+        std::function<void(const match_container_type&)> m_commit_handler;
+
+        static size_t rebase_match_index(size_t index, size_t base_index, size_t new_base_index, size_t new_prev_index) {
+            if (index == match_record_type::npos) {
+                return index;
+            }
+            return index >= base_index ? index - base_index + new_base_index : new_prev_index;
+        }
+
+        bool can_memoize() const {
+            return m_left_recursion_depth == 0 && !m_match_parse_state_lagging;
+        }
+
+        static bool is_same_parse_state(const parse_state_type& a, const parse_state_type& b) {
+            return a.m_match_count == b.m_match_count && a.m_iterator == b.m_iterator;
+        }
+
+        void update_oldest_match_index() {
+            const size_t index = m_match_records.size() - 1;
+            if (index == 0 || (m_oldest_match_index != npos && is_iterator_before(m_match_records[index].begin(), m_match_records[m_oldest_match_index].begin()))) {
+                m_oldest_match_index = index;
+            }
+        }
+
+        void update_oldest_error_index() {
+            const size_t index = m_errors.size() - 1;
+            if (index == 0 || (m_oldest_error_index != npos && is_iterator_before(m_errors[index].begin(), m_errors[m_oldest_error_index].begin()))) {
+                m_oldest_error_index = index;
+            }
+        }
+
+        void invalidate_oldest_indexes() {
+            if (m_oldest_match_index >= m_match_records.size()) {
+                m_oldest_match_index = npos;
+            }
+            if (m_oldest_error_index >= m_errors.size()) {
+                m_oldest_error_index = npos;
+            }
+        }
+
+        size_t get_oldest_match_index() {
+            if (m_oldest_match_index == npos) {
+                for (size_t index = m_match_records.size() - 1; index != match_record_type::npos; index = m_match_records[index].m_prev_sibling) {
+                    if (m_oldest_match_index == npos || !is_iterator_before(m_match_records[m_oldest_match_index].begin(), m_match_records[index].begin())) {
+                        m_oldest_match_index = index;
+                    }
+                }
+            }
+            return m_oldest_match_index;
+        }
+
+        size_t get_oldest_error_index() {
+            if (m_oldest_error_index == npos) {
+                for (size_t index = 0; index < m_errors.size(); ++index) {
+                    if (m_oldest_error_index == npos || is_iterator_before(m_errors[index].begin(), m_errors[m_oldest_error_index].begin())) {
+                        m_oldest_error_index = index;
+                    }
+                }
+            }
+            return m_oldest_error_index;
+        }
+
+        const Iterator& get_oldest_live_iterator() {
+            const Iterator* result = &get_match_parse_state().m_iterator;
+            if (!m_match_records.empty()) {
+                const Iterator& match_begin = m_match_records[get_oldest_match_index()].begin();
+                if (is_iterator_before(match_begin, *result)) {
+                    result = &match_begin;
+                }
+            }
+            if (!m_errors.empty()) {
+                const Iterator& error_begin = m_errors[get_oldest_error_index()].begin();
+                if (is_iterator_before(error_begin, *result)) {
+                    result = &error_begin;
+                }
+            }
+            if (!m_open_partition_iterators.empty() && is_iterator_before(m_open_partition_iterators.front(), *result)) {
+                result = &m_open_partition_iterators.front();
+            }
+            return *result;
+        }
 
         void lock_iterator() {
             m_state.m_end_iterator = m_state.m_parse_state.m_iterator;
+            m_iterator_locked = true;
         }
 
         void unlock_iterator() {
             m_state.m_end_iterator = m_end_iterator;
+            m_iterator_locked = false;
         }
 
         void set_match_parse_state(const parse_state_type& state) {
             m_state.m_match_parse_state = state;
+            m_match_parse_state_lagging = !is_same_parse_state(state, m_state.m_parse_state);
         }
 
-        bool handle_left_recursion(const parse_node_type* parse_node, left_recursion_state_type& left_recursion_state) {
-            parse_state_type base_match_parse_state = get_match_parse_state();
-            const left_recursion_state_type prev_left_recursion_state = left_recursion_state;
-            left_recursion_state = left_recursion_state_type(m_state.m_parse_state.m_iterator, left_recursion_status::reject);
+        void erase_left_recursion_checkpoint_states(size_t count) {
+            m_left_recursion_checkpoint_states.erase(m_left_recursion_checkpoint_states.begin() + count, m_left_recursion_checkpoint_states.end());
+        }
 
-            try {
-                const bool result = parse_node->parse(*this);
-                if (!result) {
-                    set_match_parse_state(base_match_parse_state);
-                    left_recursion_state = prev_left_recursion_state;
-                    return false;
+        left_recursion_slot& get_left_recursion_slot(const parse_node_type* rule, size_t rule_index) {
+            if (rule_index != npos_rule_index) {
+                if (rule_index >= m_left_recursion_states.size()) {
+                    m_left_recursion_states.resize(rule_index + 1);
+                }
+                left_recursion_slot& slot = m_left_recursion_states[rule_index];
+                if (!slot.m_rule || slot.m_rule == rule) {
+                    return slot;
                 }
             }
-            catch (...) {
+            return m_hashed_left_recursion_states[rule];
+        }
+
+        parse_result parse_rule(const parse_node_type* rule, size_t rule_index, const parse_node_type* parse_node, bool left_recursive) {
+            if (left_recursive) {
+                return parse_left_recursion(rule, rule_index, parse_node);
+            }
+            return parse_node->parse(*this);
+        }
+
+        bool is_left_recursion_of(const parse_result& result, const parse_node_type* rule) const {
+            return result.is_left_recursion() && m_left_recursion_rule == rule;
+        }
+
+        parse_result handle_left_recursion(const parse_node_type* rule, size_t rule_index, const parse_node_type* parse_node) {
+            ++m_left_recursion_depth;
+            const size_t cut_scope = begin_cut_scope();
+            const parse_result result = handle_left_recursion_phases(rule, rule_index, parse_node);
+            end_cut_scope(cut_scope);
+            --m_left_recursion_depth;
+            return result;
+        }
+
+        parse_result handle_left_recursion_phases(const parse_node_type* rule, size_t rule_index, const parse_node_type* parse_node) {
+            const parse_state_type base_match_parse_state = get_match_parse_state();
+            const size_t base_checkpoint_state_count = m_left_recursion_checkpoint_states.size();
+            const left_recursion_state_type prev_left_recursion_state = get_left_recursion_slot(rule, rule_index).m_state;
+            get_left_recursion_slot(rule, rule_index).m_state = left_recursion_state_type(m_state.m_parse_state.m_iterator, left_recursion_status::reject);
+
+            const parse_result result = parse_node->parse(*this);
+            if (!result) {
+                erase_left_recursion_checkpoint_states(base_checkpoint_state_count);
                 set_match_parse_state(base_match_parse_state);
-                left_recursion_state = prev_left_recursion_state;
-                throw;
+                get_left_recursion_slot(rule, rule_index).m_state = prev_left_recursion_state;
+                return result;
             }
 
             for (;;) {
+                erase_left_recursion_checkpoint_states(base_checkpoint_state_count);
                 set_match_parse_state(base_match_parse_state);
                 lock_iterator();
-                left_recursion_state = left_recursion_state_type(m_state.m_parse_state.m_iterator, left_recursion_status::accept);
-
-                try {
-                    const bool result = parse_node->parse(*this);
-                    if (!result) {
-                        set_match_parse_state(base_match_parse_state);
-                        unlock_iterator();
-                        left_recursion_state = prev_left_recursion_state;
-                        break;
-                    }
-                }
-                catch (...) {
+                get_left_recursion_slot(rule, rule_index).m_state = left_recursion_state_type(m_state.m_parse_state.m_iterator, left_recursion_status::accept);
+
+                const size_t base_cut_count = m_cut_count;
+                const parse_result result = parse_node->parse(*this);
+                if (!result) {
+                    erase_left_recursion_checkpoint_states(base_checkpoint_state_count);
                     set_match_parse_state(base_match_parse_state);
                     unlock_iterator();
-                    left_recursion_state = prev_left_recursion_state;
-                    throw;
+                    get_left_recursion_slot(rule, rule_index).m_state = prev_left_recursion_state;
+                    if (result.is_left_recursion() || m_cut_count != base_cut_count) {
+                        return result;
+                    }
+                    break;
                 }
             }
 
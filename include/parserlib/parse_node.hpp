@@ -3,11 +3,28 @@
 
 
 #include <string>
+#include "parse_result.hpp"
 
 
 namespace parserlib {
 
 
+    template <class ParseContext>
+    class grammar_analysis;
+
+
+    template <class ParseContext>
+    class bytecode_compiler;
+
+
+    template <class ParseContext>
+    class grammar_optimizer;
+
+
+    template <class ParseContext>
+    class parse_node_ptr;
+
+
     template <class ParseContext>
     class parse_node {
     public:
@@ -19,7 +36,22 @@ namespace parserlib {
             m_name = name;
         }
 
-        virtual bool parse(ParseContext& pc) const = 0;
+        virtual parse_result parse(ParseContext& pc) const = 0;
+
+        virtual bool analyze(grammar_analysis<ParseContext>& analysis) const {
+            return analysis.analyze_opaque();
+        }
+
+        virtual void freeze(const grammar_analysis<ParseContext>&) {
+        }
+
+        virtual void compile(bytecode_compiler<ParseContext>& compiler) const {
+            compiler.compile_parse_node(this);
+        }
+
+        virtual parse_node_ptr<ParseContext> optimize(grammar_optimizer<ParseContext>&) {
+            return {};
+        }
 
     protected:
         virtual ~parse_node() {
@@ -13,6 +13,13 @@ namespace parserlib {
     class rule;
 
 
+    class static_expression;
+
+
+    template <class ParseContext, class Expression>
+    class static_parse_node;
+
+
     template <class ParseContext>
     class parse_node_ptr {
     public:
@@ -64,7 +71,7 @@ namespace parserlib {
             return *this;
         }
 
-        bool parse(ParseContext& pc) const {
+        parse_result parse(ParseContext& pc) const {
             return m_parse_node->parse(pc);
         }
 
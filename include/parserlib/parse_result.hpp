@@ -0,0 +1,46 @@
+#ifndef PARSERLIB_PARSE_RESULT_HPP
+#define PARSERLIB_PARSE_RESULT_HPP
+
+
+namespace parserlib {
+
+
+    class parse_result {
+    public:
+        enum value_type {
+            failure,
+            success,
+            left_recursion
+        };
+
+        parse_result(bool result = false)
+            : m_value(result ? success : failure)
+        {
+        }
+
+        parse_result(value_type value)
+            : m_value(value)
+        {
+        }
+
+        value_type get_value() const {
+            return m_value;
+        }
+
+        bool is_left_recursion() const {
+            return m_value == left_recursion;
+        }
+
+        operator bool () const {
+            return m_value == success;
+        }
+
+    private:
+        value_type m_value;
+    };
+
+
+} //namespace parserlib
+
+
+#endif //PARSERLIB_PARSE_RESULT_HPP
@@ -2,11 +2,15 @@
 #define PARSERLIB_PARSER_HPP
 
 
+#include <vector>
+#include <string_view>
+#include <initializer_list>
 #include "parse_context.hpp"
 #include "set_parse_node.hpp"
 #include "range_parse_node.hpp"
 #include "any_parse_node.hpp"
 #include "end_parse_node.hpp"
+#include "cut_parse_node.hpp"
 #include "newline_parse_node.hpp"
 #include "function_parse_node.hpp"
 #include "error_parse_node.hpp"
@@ -14,6 +18,11 @@
 #include "skip_after_parse_node.hpp"
 #include "rule.hpp"
 #include "debug_parse_node.hpp"
+#include "one_of_parse_node.hpp"
+#include "until_parse_node.hpp"
+#include "integer_parse_node.hpp"
+#include "decimal_parse_node.hpp"
+#include "identifier_parse_node.hpp"
 
 
 namespace parserlib {
@@ -43,7 +52,6 @@ namespace parserlib {
         using error_container_type = typename parse_context::error_container_type;
 
         using parse_node_type = parse_node<parse_context>;
-        using left_recursion_exception_type = left_recursion_exception<parse_context>;
 
         template <class DerivedMatchId, class DerivedErrorId, class DerivedSymbolComparator = default_symbol_comparator>
         struct derived_parser {
@@ -73,6 +81,71 @@ namespace parserlib {
             return std::make_shared<range_parse_node<parse_context, Symbol>>(min, max);
         }
 
+        template <class Symbol>
+        static parse_node_ptr one_of(std::initializer_list<const Symbol*> strings, one_of_match match = one_of_match::first) {
+            std::vector<std::vector<int>> result;
+            for (const Symbol* string : strings) {
+                const std::basic_string_view<Symbol> view(string);
+                result.emplace_back(view.begin(), view.end());
+            }
+            return std::make_shared<one_of_parse_node<parse_context>>(result, match);
+        }
+
+        template <class Symbol>
+        static parse_node_ptr one_of(const std::vector<std::basic_string<Symbol>>& strings, one_of_match match = one_of_match::first) {
+            std::vector<std::vector<int>> result;
+            for (const std::basic_string<Symbol>& string : strings) {
+                result.emplace_back(string.begin(), string.end());
+            }
+            return std::make_shared<one_of_parse_node<parse_context>>(result, match);
+        }
+
+        template <class Symbol>
+        static parse_node_ptr until(const Symbol& terminator, until_terminator mode = until_terminator::exclude) {
+            return std::make_shared<until_parse_node<parse_context, Symbol>>(std::basic_string<Symbol>(1, terminator), mode);
+        }
+
+        template <class Symbol>
+        static parse_node_ptr until(const Symbol* terminator, until_terminator mode = until_terminator::exclude) {
+            return std::make_shared<until_parse_node<parse_context, Symbol>>(terminator, mode);
+        }
+
+        template <class Symbol>
+        static parse_node_ptr until(const Symbol& terminator, const Symbol& escape, until_terminator mode = until_terminator::exclude) {
+            return std::make_shared<until_parse_node<parse_context, Symbol>>(std::basic_string<Symbol>(1, terminator), escape, mode);
+        }
+
+        template <class Symbol>
+        static parse_node_ptr until(const Symbol* terminator, const Symbol& escape, until_terminator mode = until_terminator::exclude) {
+            return std::make_shared<until_parse_node<parse_context, Symbol>>(terminator, escape, mode);
+        }
+
+        static parse_node_ptr integer(number_sign sign = number_sign::none) {
+            return std::make_shared<integer_parse_node<parse_context>>(sign);
+        }
+
+        static parse_node_ptr decimal(number_sign sign = number_sign::none) {
+            return std::make_shared<decimal_parse_node<parse_context>>(sign);
+        }
+
+        static parse_node_ptr identifier(const parse_node_ptr& first, const parse_node_ptr& rest) {
+            return std::make_shared<identifier_parse_node<parse_context>>(first, rest);
+        }
+
+        static parse_node_ptr identifier() {
+            return identifier(range('a', 'z') | range('A', 'Z') | '_', range('a', 'z') | range('A', 'Z') | range('0', '9') | '_');
+        }
+
+        template <class Symbol = char>
+        static parse_node_ptr quoted(const Symbol& quote = '"', const Symbol& escape = '\\') {
+            return terminal(quote) >> until(quote, escape, until_terminator::include);
+        }
+
+        template <class Symbol>
+        static parse_node_ptr line_comment(const Symbol* prefix) {
+            return terminal(prefix) >> until(static_cast<Symbol>('\n'));
+        }
+
         static parse_node_ptr any() {
             return std::make_shared<any_parse_node<parse_context>>();
         }
@@ -81,6 +154,10 @@ namespace parserlib {
             return std::make_shared<end_parse_node<parse_context>>();
         }
 
+        static parse_node_ptr cut() {
+            return std::make_shared<cut_parse_node<parse_context>>();
+        }
+
         static parse_node_ptr newline(const parse_node_ptr& parse_node) {
             return std::make_shared<newline_parse_node<parse_context>>(parse_node);
         }
@@ -3,7 +3,9 @@
 
 
 #include <cassert>
+#include <type_traits>
 #include "parse_node.hpp"
+#include "parse_context.hpp"
 
 
 namespace parserlib {
@@ -12,17 +14,38 @@ namespace parserlib {
     template <class ParseContext, class Symbol>
     class range_parse_node : public parse_node<ParseContext> {
     public:
+        static constexpr bool is_folded = has_symbol_fold_v<typename ParseContext::symbol_comparator_type>;
+
         range_parse_node(const Symbol& min, const Symbol& max) 
             : m_min(min)
             , m_max(max)
         {
             assert(m_min <= m_max);
+            if constexpr (is_folded) {
+                m_folded_min = ParseContext::symbol_comparator_type::fold(static_cast<int>(min));
+                m_folded_max = ParseContext::symbol_comparator_type::fold(static_cast<int>(max));
+            }
+        }
+
+        const Symbol& get_min() const {
+            return m_min;
         }
 
-        bool parse(ParseContext& pc) const override {
+        const Symbol& get_max() const {
+            return m_max;
+        }
+
+        parse_result parse(ParseContext& pc) const override {
             if (pc.is_valid_iterator()) {
                 const auto& token = *pc.get_iterator();
-                if (pc.compare(token, m_min) >= 0 && pc.compare(token, m_max) <= 0) {
+                if constexpr (is_folded) {
+                    const int folded_token = ParseContext::symbol_comparator_type::fold(static_cast<int>(token));
+                    if (folded_token >= m_folded_min && folded_token <= m_folded_max) {
+                        pc.increment_iterator();
+                        return true;
+                    }
+                }
+                else if (pc.compare(token, m_min) >= 0 && pc.compare(token, m_max) <= 0) {
                     pc.increment_iterator();
                     return true;
                 }
@@ -30,8 +53,22 @@ namespace parserlib {
             return false;
         }
 
+        bool analyze(grammar_analysis<ParseContext>& analysis) const override {
+            return analysis.analyze_range(m_min, m_max);
+        }
+
+        void compile(bytecode_compiler<ParseContext>& compiler) const override {
+            if constexpr (std::is_integral_v<Symbol> || std::is_enum_v<Symbol>) {
+                compiler.compile_range(static_cast<int>(m_min), static_cast<int>(m_max));
+            }
+            else {
+                compiler.compile_parse_node(this);
+            }
+        }
+
     private:
         Symbol m_min, m_max;
+        int m_folded_min{ 0 }, m_folded_max{ 0 };
     };
 
 
@@ -2,7 +2,7 @@
 #define PARSERLIB_REF_PARSE_NODE_HPP
 
 
-#include "parse_node.hpp"
+#include "rule_parse_node.hpp"
 
 
 namespace parserlib {
@@ -11,17 +11,33 @@ namespace parserlib {
     template <class ParseContext>
     class ref_parse_node : public parse_node<ParseContext> {
     public:
-        ref_parse_node(const parse_node_ptr<ParseContext>& parse_node)
-            : m_parse_node(parse_node.get_shared())
+        ref_parse_node(const std::shared_ptr<rule_parse_node<ParseContext>>& rule_parse_node)
+            : m_rule_parse_node(rule_parse_node)
         {
         }
 
-        bool parse(ParseContext& pc) const override {
-            return m_parse_node->parse(pc);
+        const std::shared_ptr<rule_parse_node<ParseContext>>& get_rule_parse_node() const {
+            return m_rule_parse_node;
+        }
+
+        parse_result parse(ParseContext& pc) const override {
+            return m_rule_parse_node->parse_rule(pc);
+        }
+
+        bool analyze(grammar_analysis<ParseContext>& analysis) const override {
+            return analysis.analyze(m_rule_parse_node.get());
+        }
+
+        void compile(bytecode_compiler<ParseContext>& compiler) const override {
+            compiler.compile(m_rule_parse_node.get());
+        }
+
+        parse_node_ptr<ParseContext> optimize(grammar_optimizer<ParseContext>& optimizer) override {
+            return optimizer.optimize_ref(m_rule_parse_node);
         }
 
     private:
-        std::shared_ptr<parse_node<ParseContext>> m_parse_node;
+        std::shared_ptr<rule_parse_node<ParseContext>> m_rule_parse_node;
     };
 
 
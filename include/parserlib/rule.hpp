@@ -24,7 +24,7 @@ namespace parserlib {
 
         template <class Symbol>
         rule(const Symbol& symbol)
-            : m_parse_node(parse_node_ptr<ParseContext>(symbol).get_shared())
+            : rule(parse_node_ptr<ParseContext>(symbol))
         {
         }
 
@@ -53,17 +53,17 @@ namespace parserlib {
 
         template <class Symbol>
         rule& operator = (const Symbol& symbol) {
-            m_parse_node = parse_node_ptr<ParseContext>(symbol).get_shared();
+            m_parse_node = get_rule_parse_node(parse_node_ptr<ParseContext>(symbol).get_shared());
             return *this;
         }
 
         rule& operator = (rule& r) {
-            m_parse_node = get_rule_parse_node(r.m_parse_node);
+            m_parse_node = get_rule_parse_node(r.m_parse_node.get_shared());
             return *this;
         }
 
         rule& operator = (bool result) {
-            m_parse_node = parse_node_ptr<ParseContext>(result);
+            m_parse_node = get_rule_parse_node(parse_node_ptr<ParseContext>(result).get_shared());
             return *this;
         }
 
@@ -80,7 +80,19 @@ namespace parserlib {
             return *this;
         }
 
-        bool parse(ParseContext& pc) const {
+        bool is_memoized() const {
+            return get_or_create_rule_parse_node()->is_memoized();
+        }
+
+        void set_memoized(bool memoized) const {
+            get_or_create_rule_parse_node()->set_memoized(memoized);
+        }
+
+        bool is_left_recursive() const {
+            return get_or_create_rule_parse_node()->is_left_recursive();
+        }
+
+        parse_result parse(ParseContext& pc) const {
             return m_parse_node->parse(pc);
         }
 
@@ -103,7 +115,7 @@ namespace parserlib {
         std::shared_ptr<rule_parse_node<ParseContext>> get_rule_parse_node(const std::shared_ptr<parse_node<ParseContext>>& ptr) const {
             rule_map& map = get_rule_map();
             auto it = map.find(this);
-            it->second->m_parse_node = ptr;
+            it->second->set_parse_node(ptr);
             return it->second;
         }
 
@@ -120,7 +132,7 @@ namespace parserlib {
 
         std::shared_ptr<rule_parse_node<ParseContext>> get_or_create_rule_parse_node(const std::shared_ptr<parse_node<ParseContext>>& ptr) const {
             std::shared_ptr<rule_parse_node<ParseContext>> result = get_or_create_rule_parse_node();
-            result->m_parse_node = ptr;
+            result->set_parse_node(ptr);
             return result;
         }
 
@@ -16,12 +16,70 @@ namespace parserlib {
         {
         }
 
-        bool parse(ParseContext& pc) const override {
-            return pc.parse_left_recursion(m_parse_node.get());
+        const std::shared_ptr<parse_node<ParseContext>>& get_parse_node() const {
+            return m_parse_node;
+        }
+
+        void set_parse_node(const std::shared_ptr<parse_node<ParseContext>>& parse_node) {
+            m_parse_node = parse_node;
+            m_left_recursive = true;
+        }
+
+        size_t get_index() const {
+            return m_index;
+        }
+
+        bool is_left_recursive() const {
+            return m_left_recursive;
+        }
+
+        bool is_memoized() const {
+            return m_memoized;
+        }
+
+        void set_memoized(bool memoized) {
+            m_memoized = memoized;
+        }
+
+        parse_result parse(ParseContext& pc) const override {
+            return parse_rule(pc);
+        }
+
+        parse_result parse_rule(ParseContext& pc) const {
+            if (m_memoized || pc.is_memoization_enabled()) {
+                return pc.parse_memoized(this, m_index, m_parse_node.get(), m_left_recursive);
+            }
+            if (m_left_recursive) {
+                return pc.parse_left_recursion(this, m_index, m_parse_node.get());
+            }
+            return m_parse_node->parse(pc);
+        }
+
+        bool analyze(grammar_analysis<ParseContext>& analysis) const override {
+            return analysis.analyze_rule(this);
+        }
+
+        void compile(bytecode_compiler<ParseContext>& compiler) const override {
+            compiler.compile_rule(this);
+        }
+
+        parse_node_ptr<ParseContext> optimize(grammar_optimizer<ParseContext>& optimizer) override {
+            if (m_parse_node) {
+                m_parse_node = optimizer.optimize(m_parse_node).get_shared();
+            }
+            return {};
+        }
+
+        void freeze(const grammar_analysis<ParseContext>& analysis) override {
+            m_left_recursive = analysis.is_left_recursive(this);
+            m_index = analysis.get_rule_index(this);
         }
 
     private:
         std::shared_ptr<parse_node<ParseContext>> m_parse_node;
+        size_t m_index{ ParseContext::npos_rule_index };
+        bool m_left_recursive{ true };
+        bool m_memoized{ false };
 
         friend class rule<ParseContext>;
     };
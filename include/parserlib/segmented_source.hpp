@@ -0,0 +1,238 @@
+#ifndef PARSERLIB_SEGMENTED_SOURCE_HPP
+#define PARSERLIB_SEGMENTED_SOURCE_HPP
+
+
+#include <vector>
+#include <string_view>
+#include <initializer_list>
+#include <iterator>
+#include <algorithm>
+#include <type_traits>
+#include <cstddef>
+#include "contiguous_iterator.hpp"
+
+
+namespace parserlib {
+
+
+    class segmented_source {
+    public:
+        using value_type = char;
+
+        class const_iterator {
+        public:
+            using iterator_category = std::random_access_iterator_tag;
+            using value_type = char;
+            using difference_type = std::ptrdiff_t;
+            using pointer = const char*;
+            using reference = const char&;
+
+            const_iterator() {
+            }
+
+            size_t get_position() const {
+                return m_position;
+            }
+
+            size_t get_segment_index() const {
+                return m_segment;
+            }
+
+            size_t get_segment_size() const {
+                return m_segment_end - m_position;
+            }
+
+            reference operator *() const {
+                return m_data[m_position - m_segment_begin];
+            }
+
+            pointer operator ->() const {
+                return &**this;
+            }
+
+            reference operator [](difference_type offset) const {
+                return *(*this + offset);
+            }
+
+            const_iterator& operator ++() {
+                ++m_position;
+                if (m_position == m_segment_end) {
+                    set_segment(m_segment + 1);
+                }
+                return *this;
+            }
+
+            const_iterator operator ++(int) {
+                const_iterator result = *this;
+                ++*this;
+                return result;
+            }
+
+            const_iterator& operator --() {
+                if (m_position == m_segment_begin) {
+                    set_segment(m_segment - 1);
+                }
+                --m_position;
+                return *this;
+            }
+
+            const_iterator operator --(int) {
+                const_iterator result = *this;
+                --*this;
+                return result;
+            }
+
+            const_iterator& operator += (difference_type count) {
+                set_position(m_position + count);
+                return *this;
+            }
+
+            const_iterator& operator -= (difference_type count) {
+                set_position(m_position - count);
+                return *this;
+            }
+
+            const_iterator operator + (difference_type count) const {
+                const_iterator result = *this;
+                result += count;
+                return result;
+            }
+
+            const_iterator operator - (difference_type count) const {
+                const_iterator result = *this;
+                result -= count;
+                return result;
+            }
+
+            difference_type operator - (const const_iterator& it) const {
+                return static_cast<difference_type>(m_position) - static_cast<difference_type>(it.m_position);
+            }
+
+            bool operator == (const const_iterator& it) const {
+                return m_position == it.m_position;
+            }
+
+            bool operator != (const const_iterator& it) const {
+                return m_position != it.m_position;
+            }
+
+            bool operator < (const const_iterator& it) const {
+                return m_position < it.m_position;
+            }
+
+            bool operator > (const const_iterator& it) const {
+                return m_position > it.m_position;
+            }
+
+            bool operator <= (const const_iterator& it) const {
+                return m_position <= it.m_position;
+            }
+
+            bool operator >= (const const_iterator& it) const {
+                return m_position >= it.m_position;
+            }
+
+        private:
+            const segmented_source* m_source{ nullptr };
+            size_t m_segment{ 0 };
+            size_t m_position{ 0 };
+            const char* m_data{ nullptr };
+            size_t m_segment_begin{ 0 };
+            size_t m_segment_end{ 0 };
+
+            const_iterator(const segmented_source* source, size_t position)
+                : m_source(source)
+            {
+                set_position(position);
+            }
+
+            void set_segment(size_t segment) {
+                m_segment = segment;
+                if (segment < m_source->m_segments.size()) {
+                    m_data = m_source->m_segments[segment].data();
+                    m_segment_begin = m_source->m_offsets[segment];
+                    m_segment_end = m_segment_begin + m_source->m_segments[segment].size();
+                }
+                else {
+                    m_data = nullptr;
+                    m_segment_begin = m_segment_end = m_source->m_size;
+                }
+            }
+
+            void set_position(size_t position) {
+                if (position < m_segment_begin || position >= m_segment_end) {
+                    const auto it = std::upper_bound(m_source->m_offsets.begin(), m_source->m_offsets.end(), position);
+                    set_segment(position < m_source->m_size ? static_cast<size_t>(it - m_source->m_offsets.begin()) - 1 : m_source->m_segments.size());
+                }
+                m_position = position;
+            }
+
+            friend class segmented_source;
+        };
+
+        using iterator = const_iterator;
+
+        segmented_source() {
+        }
+
+        segmented_source(std::initializer_list<std::string_view> segments) {
+            for (const std::string_view& segment : segments) {
+                add_segment(segment);
+            }
+        }
+
+        template <class Container>
+        explicit segmented_source(const Container& segments) {
+            for (const auto& segment : segments) {
+                add_segment(std::string_view(segment.data(), segment.size()));
+            }
+        }
+
+        void add_segment(std::string_view segment) {
+            if (!segment.empty()) {
+                m_segments.push_back(segment);
+                m_offsets.push_back(m_size);
+                m_size += segment.size();
+            }
+        }
+
+        void add_segment(const char* data, size_t size) {
+            add_segment(std::string_view(data, size));
+        }
+
+        const std::vector<std::string_view>& get_segments() const {
+            return m_segments;
+        }
+
+        size_t size() const {
+            return m_size;
+        }
+
+        bool empty() const {
+            return m_size == 0;
+        }
+
+        const_iterator begin() const {
+            return const_iterator(this, 0);
+        }
+
+        const_iterator end() const {
+            return const_iterator(this, m_size);
+        }
+
+    private:
+        std::vector<std::string_view> m_segments;
+        std::vector<size_t> m_offsets;
+        size_t m_size{ 0 };
+    };
+
+
+    template <>
+    struct is_segmented_iterator<segmented_source::const_iterator> : std::true_type {
+    };
+
+
+} //namespace parserlib
+
+
+#endif //PARSERLIB_SEGMENTED_SOURCE_HPP
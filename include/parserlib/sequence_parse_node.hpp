@@ -21,23 +21,39 @@ namespace parserlib {
             return m_parse_nodes;
         }
 
-        bool parse(ParseContext& pc) const override {
-            const auto base_state = pc.get_state();
-            try {
-                for (const parse_node_ptr<ParseContext>& parse_node : m_parse_nodes) {
-                    if (!parse_node->parse(pc)) {
-                        pc.set_state(base_state);
-                        return false;
-                    }
+        parse_result parse(ParseContext& pc) const override {
+            const auto base_checkpoint = pc.get_checkpoint();
+            for (const parse_node_ptr<ParseContext>& parse_node : m_parse_nodes) {
+                const parse_result result = parse_node->parse(pc);
+                if (!result) {
+                    pc.restore_checkpoint(base_checkpoint);
+                    return result;
                 }
             }
-            catch (...) {
-                pc.set_state(base_state);
-                throw;
-            }
             return true;
         }
 
+        bool analyze(grammar_analysis<ParseContext>& analysis) const override {
+            bool nullable = true;
+            for (const parse_node_ptr<ParseContext>& parse_node : m_parse_nodes) {
+                if (!analysis.analyze(parse_node.get(), nullable)) {
+                    nullable = false;
+                }
+            }
+            return nullable;
+        }
+
+        void compile(bytecode_compiler<ParseContext>& compiler) const override {
+            compiler.compile_sequence(m_parse_nodes);
+        }
+
+        parse_node_ptr<ParseContext> optimize(grammar_optimizer<ParseContext>& optimizer) override {
+            for (parse_node_ptr<ParseContext>& parse_node : m_parse_nodes) {
+                parse_node = optimizer.optimize(parse_node);
+            }
+            return optimizer.optimize_sequence(m_parse_nodes);
+        }
+
     private:
         std::vector<parse_node_ptr<ParseContext>> m_parse_nodes;
     };
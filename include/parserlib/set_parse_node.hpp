@@ -5,7 +5,9 @@
 #include <string_view>
 #include <vector>
 #include <algorithm>
+#include <type_traits>
 #include "parse_node.hpp"
+#include "symbol_set.hpp"
 
 
 namespace parserlib {
@@ -15,30 +17,40 @@ namespace parserlib {
     class set_parse_node : public parse_node<ParseContext> {
     public:
         set_parse_node(const std::basic_string_view<Symbol>& set)
-            : m_set(set.begin(), set.end())
+            : m_set(set)
         {
-            std::sort(m_set.begin(), m_set.end());
         }
 
-        bool parse(ParseContext& pc) const override {
-            if (pc.is_valid_iterator()) {
-                const auto& token = *pc.get_iterator();
-                auto it = std::upper_bound(m_set.begin(), m_set.end(), token, [&](const auto& a,const auto& b) {
-                    return pc.compare(a, b) < 0;
-                });
-                if (it != m_set.begin()) {
-                    --it;
-                    if (pc.compare(token, *it) == 0) {
-                        pc.increment_iterator();
-                        return true;
-                    }
-                }
+        const std::vector<Symbol>& get_set() const {
+            return m_set.get_symbols();
+        }
+
+        parse_result parse(ParseContext& pc) const override {
+            if (pc.is_valid_iterator() && m_set.contains(*pc.get_iterator())) {
+                pc.increment_iterator();
+                return true;
+            }
+            return false;
+        }
+
+        bool analyze(grammar_analysis<ParseContext>& analysis) const override {
+            for (const Symbol& symbol : get_set()) {
+                analysis.analyze_symbol(symbol);
             }
             return false;
         }
 
+        void compile(bytecode_compiler<ParseContext>& compiler) const override {
+            if constexpr (std::is_integral_v<Symbol> || std::is_enum_v<Symbol>) {
+                compiler.compile_set(std::vector<int>(get_set().begin(), get_set().end()));
+            }
+            else {
+                compiler.compile_parse_node(this);
+            }
+        }
+
     private:
-        std::vector<Symbol> m_set;
+        symbol_set<ParseContext, Symbol> m_set;
     };
 
 
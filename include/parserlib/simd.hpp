@@ -0,0 +1,32 @@
+#ifndef PARSERLIB_SIMD_HPP
+#define PARSERLIB_SIMD_HPP
+
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define PARSERLIB_SSE2
+#endif
+
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+
+
+namespace parserlib {
+
+
+    inline unsigned count_trailing_zeros(unsigned value) {
+#ifdef _MSC_VER
+        unsigned long index;
+        _BitScanForward(&index, value);
+        return static_cast<unsigned>(index);
+#else
+        return static_cast<unsigned>(__builtin_ctz(value));
+#endif
+    }
+
+
+} //namespace parserlib
+
+
+#endif //PARSERLIB_SIMD_HPP
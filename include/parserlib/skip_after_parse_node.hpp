@@ -3,6 +3,7 @@
 
 
 #include "parse_node.hpp"
+#include "skip_prefilter.hpp"
 
 
 namespace parserlib {
@@ -16,39 +17,67 @@ namespace parserlib {
         {
         }
 
-        bool parse(ParseContext& pc) const override {
-            const auto initial_state = pc.get_state();
+        parse_result parse(ParseContext& pc) const override {
+            const auto initial_checkpoint = pc.get_checkpoint();
 
-            try {
-                for (;;) {
-                    const auto base_state = pc.get_state();
+            for (;;) {
+                const auto base_checkpoint = pc.get_checkpoint();
 
-                    const bool result = m_parse_node->parse(pc);
+                const parse_result result = m_parse_node->parse(pc);
 
-                    if (result) {
-                        return true;
-                    }
+                if (result) {
+                    return true;
+                }
 
-                    pc.set_state(base_state);
+                if (!pc.restore_checkpoint(base_checkpoint)) {
+                    return result;
+                }
 
-                    if (!pc.is_valid_iterator()) {
-                        break;
-                    }
+                if (result.is_left_recursion()) {
+                    pc.restore_checkpoint(initial_checkpoint);
+                    return result;
+                }
 
-                    pc.increment_iterator();
+                if (!pc.is_valid_iterator()) {
+                    break;
                 }
-            }
 
-            catch (...) {
-                pc.set_state(initial_state);
-                throw;
+                pc.increment_iterator();
+
+                if (m_prefilter.is_enabled()) {
+                    m_prefilter.skip(pc);
+                }
             }
 
             return false;
         }
 
+        bool analyze(grammar_analysis<ParseContext>& analysis) const override {
+            analysis.analyze_any();
+            return analysis.analyze(m_parse_node.get());
+        }
+
+        void freeze(const grammar_analysis<ParseContext>& analysis) override {
+            m_prefilter.build(analysis, m_parse_node.get());
+        }
+
+        parse_node_ptr<ParseContext> optimize(grammar_optimizer<ParseContext>& optimizer) override {
+            m_prefilter.reset();
+            m_parse_node = optimizer.optimize(m_parse_node);
+            return {};
+        }
+
+        bool is_prefiltered() const {
+            return m_prefilter.is_enabled();
+        }
+
+        const skip_prefilter<ParseContext>& get_prefilter() const {
+            return m_prefilter;
+        }
+
     private:
         parse_node_ptr<ParseContext> m_parse_node;
+        skip_prefilter<ParseContext> m_prefilter;
     };
 
 
@@ -0,0 +1,168 @@
+#ifndef PARSERLIB_SKIP_PREFILTER_HPP
+#define PARSERLIB_SKIP_PREFILTER_HPP
+
+
+#include <bitset>
+#include <array>
+#include <vector>
+#include <iterator>
+#include <type_traits>
+#include "parse_node.hpp"
+#include "contiguous_iterator.hpp"
+#include "symbol_class.hpp"
+#include "aho_corasick.hpp"
+#include "symbol_parse_node.hpp"
+#include "string_parse_node.hpp"
+#include "one_of_parse_node.hpp"
+#include "choice_parse_node.hpp"
+
+
+namespace parserlib {
+
+
+    template <class ParseContext>
+    class skip_prefilter {
+    public:
+        using token_type = typename std::iterator_traits<typename ParseContext::iterator_type>::value_type;
+
+        bool is_enabled() const {
+            return m_mode != mode::none;
+        }
+
+        bool is_multi_pattern() const {
+            return m_mode == mode::patterns;
+        }
+
+        void reset() {
+            m_mode = mode::none;
+        }
+
+        void build(const grammar_analysis<ParseContext>& analysis, const parse_node<ParseContext>* parse_node) {
+            m_mode = mode::none;
+            if constexpr (std::is_integral_v<token_type> && sizeof(token_type) == 1) {
+                const auto& first = analysis.get_first_set(parse_node);
+                if (analysis.is_nullable(parse_node) || first.is_any()) {
+                    return;
+                }
+
+                if constexpr (one_of_parse_node<ParseContext>::is_keyed_comparator) {
+                    std::vector<std::vector<int>> strings;
+                    if (get_strings(parse_node, strings) && build_patterns(strings)) {
+                        m_mode = mode::patterns;
+                        return;
+                    }
+                }
+
+                std::bitset<256> skipped;
+                for (size_t index = 0; index < skipped.size(); ++index) {
+                    skipped[index] = !first.template contains<ParseContext>(static_cast<int>(static_cast<token_type>(index)));
+                }
+                m_skipped = symbol_class(skipped);
+                m_mode = mode::symbols;
+            }
+        }
+
+        void skip(ParseContext& pc) const {
+            using iterator_type = typename ParseContext::iterator_type;
+            if constexpr (is_contiguous_iterator_v<iterator_type>) {
+                const size_t size = static_cast<size_t>(pc.get_end_iterator() - pc.get_iterator());
+                if (size > 0) {
+                    const unsigned char* data = reinterpret_cast<const unsigned char*>(get_iterator_address(pc.get_iterator()));
+                    if (m_mode == mode::patterns) {
+                        const size_t start = m_patterns.find(data, data + size);
+                        pc.increment_iterator(start != aho_corasick::npos ? start : size);
+                    }
+                    else {
+                        pc.increment_iterator(m_skipped.scan(data, size));
+                    }
+                }
+            }
+            else if (m_mode == mode::patterns) {
+                const size_t start = m_patterns.find(pc.get_iterator(), pc.get_end_iterator());
+                if (start != aho_corasick::npos) {
+                    pc.increment_iterator(start);
+                    return;
+                }
+                while (pc.is_valid_iterator()) {
+                    pc.increment_iterator();
+                }
+            }
+            else {
+                while (pc.is_valid_iterator() && m_skipped.contains(*pc.get_iterator())) {
+                    pc.increment_iterator();
+                }
+            }
+        }
+
+    private:
+        enum class mode {
+            none,
+            symbols,
+            patterns
+        };
+
+        symbol_class m_skipped;
+        aho_corasick m_patterns;
+        mode m_mode{ mode::none };
+
+        template <class Symbol>
+        static int get_key(const Symbol& symbol) {
+            return get_symbol_key<typename ParseContext::symbol_comparator_type>(symbol);
+        }
+
+        static bool get_strings(const parse_node<ParseContext>* parse_node, std::vector<std::vector<int>>& strings) {
+            if (const auto* choice = dynamic_cast<const choice_parse_node<ParseContext>*>(parse_node)) {
+                for (const parse_node_ptr<ParseContext>& alternative : choice->get_parse_nodes()) {
+                    if (!get_strings(alternative.get(), strings)) {
+                        return false;
+                    }
+                }
+                return true;
+            }
+            if (const auto* one_of = dynamic_cast<const one_of_parse_node<ParseContext>*>(parse_node)) {
+                strings.insert(strings.end(), one_of->get_strings().begin(), one_of->get_strings().end());
+                return true;
+            }
+            if (const auto* string = dynamic_cast<const string_parse_node<ParseContext, token_type>*>(parse_node)) {
+                strings.emplace_back(string->get_string().begin(), string->get_string().end());
+                return true;
+            }
+            if (const auto* symbol = dynamic_cast<const symbol_parse_node<ParseContext, token_type>*>(parse_node)) {
+                strings.emplace_back(1, static_cast<int>(symbol->get_symbol()));
+                return true;
+            }
+            return false;
+        }
+
+        bool build_patterns(const std::vector<std::vector<int>>& strings) {
+            bool has_long_string = false;
+            std::vector<std::vector<unsigned char>> patterns;
+            for (const std::vector<int>& string : strings) {
+                std::vector<unsigned char> pattern;
+                for (const int symbol : string) {
+                    if (static_cast<int>(static_cast<token_type>(symbol)) != symbol) {
+                        return false;
+                    }
+                    pattern.push_back(static_cast<unsigned char>(get_key(static_cast<token_type>(symbol))));
+                }
+                if (pattern.size() > 1) {
+                    has_long_string = true;
+                }
+                patterns.push_back(std::move(pattern));
+            }
+            if (!has_long_string) {
+                return false;
+            }
+            std::array<unsigned char, 256> keys;
+            for (size_t index = 0; index < keys.size(); ++index) {
+                keys[index] = static_cast<unsigned char>(get_key(static_cast<token_type>(index)));
+            }
+            return m_patterns.build(patterns, keys);
+        }
+    };
+
+
+} //namespace parserlib
+
+
+#endif //PARSERLIB_SKIP_PREFILTER_HPP
@@ -0,0 +1,115 @@
+#ifndef PARSERLIB_SPAN_PARSE_NODE_HPP
+#define PARSERLIB_SPAN_PARSE_NODE_HPP
+
+
+#include <bitset>
+#include <iterator>
+#include <limits>
+#include <type_traits>
+#include "parse_node_ptr.hpp"
+#include "contiguous_iterator.hpp"
+#include "symbol_class.hpp"
+
+
+namespace parserlib {
+
+
+    template <class ParseContext>
+    class span_parse_node : public parse_node<ParseContext> {
+    public:
+        using token_type = typename std::iterator_traits<typename ParseContext::iterator_type>::value_type;
+
+        static_assert(std::is_integral_v<token_type> && sizeof(token_type) == 1, "span_parse_node requires byte-sized symbols");
+
+        span_parse_node(const parse_node_ptr<ParseContext>& parse_node, const std::bitset<256>& symbols, size_t min_count)
+            : m_parse_node(parse_node)
+            , m_symbols(symbols)
+            , m_min_count(min_count)
+        {
+        }
+
+        const parse_node_ptr<ParseContext>& get_parse_node() const {
+            return m_parse_node;
+        }
+
+        const std::bitset<256>& get_symbols() const {
+            return m_symbols.get_symbols();
+        }
+
+        size_t get_min_count() const {
+            return m_min_count;
+        }
+
+        parse_result parse(ParseContext& pc) const override {
+            using iterator_type = typename ParseContext::iterator_type;
+            if constexpr (is_contiguous_iterator_v<iterator_type>) {
+                const size_t size = static_cast<size_t>(pc.get_end_iterator() - pc.get_iterator());
+                size_t count;
+                if constexpr (is_padded_iterator_v<iterator_type>) {
+                    count = m_symbols.scan_padded(reinterpret_cast<const unsigned char*>(get_iterator_address(pc.get_iterator())), size);
+                }
+                else {
+                    count = size > 0 ? m_symbols.scan(reinterpret_cast<const unsigned char*>(get_iterator_address(pc.get_iterator())), size) : 0;
+                }
+                if (count < m_min_count) {
+                    return false;
+                }
+                pc.increment_iterator(count);
+            }
+            else if constexpr (is_segmented_iterator_v<iterator_type>) {
+                size_t count = 0;
+                for (;;) {
+                    const size_t size = get_segment_size(pc.get_iterator(), pc.get_end_iterator());
+                    const size_t segment_count = size > 0 ? m_symbols.scan(reinterpret_cast<const unsigned char*>(get_iterator_address(pc.get_iterator())), size) : 0;
+                    pc.increment_iterator(segment_count);
+                    count += segment_count;
+                    if (segment_count < size || size == 0) {
+                        break;
+                    }
+                }
+                if (count < m_min_count) {
+                    return false;
+                }
+            }
+            else {
+                size_t count = 0;
+                while (pc.is_valid_iterator() && m_symbols.contains(*pc.get_iterator())) {
+                    pc.increment_iterator();
+                    ++count;
+                }
+                if (count < m_min_count) {
+                    return false;
+                }
+            }
+            return true;
+        }
+
+        bool analyze(grammar_analysis<ParseContext>& analysis) const override {
+            for (long long symbol = std::numeric_limits<token_type>::min(); symbol <= std::numeric_limits<token_type>::max(); ++symbol) {
+                if (m_symbols.contains(static_cast<token_type>(symbol))) {
+                    analysis.analyze_symbol(static_cast<token_type>(symbol));
+                }
+            }
+            return m_min_count == 0;
+        }
+
+        void compile(bytecode_compiler<ParseContext>& compiler) const override {
+            if (m_min_count == 0) {
+                compiler.compile_loop_0(m_parse_node.get());
+            }
+            else {
+                compiler.compile_loop_1(m_parse_node.get());
+            }
+        }
+
+    private:
+        parse_node_ptr<ParseContext> m_parse_node;
+        symbol_class m_symbols;
+        size_t m_min_count;
+    };
+
+
+} //namespace parserlib
+
+
+#endif //PARSERLIB_SPAN_PARSE_NODE_HPP
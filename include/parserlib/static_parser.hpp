@@ -0,0 +1,795 @@
+#ifndef PARSERLIB_STATIC_PARSER_HPP
+#define PARSERLIB_STATIC_PARSER_HPP
+
+
+#include <string_view>
+#include <vector>
+#include <algorithm>
+#include <type_traits>
+#include "parser.hpp"
+#include "grammar_analysis.hpp"
+#include "string_compare.hpp"
+#include "symbol_set.hpp"
+
+
+namespace parserlib {
+
+
+    class static_expression {
+    };
+
+
+    template <class T>
+    inline constexpr bool is_static_expression_v = std::is_base_of_v<static_expression, T>;
+
+
+    template <class Symbol>
+    class static_symbol : public static_expression {
+    public:
+        static_symbol(const Symbol& symbol)
+            : m_symbol(symbol)
+        {
+        }
+
+        template <class ParseContext>
+        parse_result parse(ParseContext& pc) const {
+            if (pc.is_valid_iterator()) {
+                const auto& token = *pc.get_iterator();
+                if (pc.compare(token, m_symbol) == 0) {
+                    pc.increment_iterator();
+                    return true;
+                }
+            }
+            return false;
+        }
+
+        template <class ParseContext>
+        bool analyze(grammar_analysis<ParseContext>& analysis) const {
+            return analysis.analyze_symbol(m_symbol);
+        }
+
+    private:
+        Symbol m_symbol;
+    };
+
+
+    template <class Symbol>
+    class static_string : public static_expression {
+    public:
+        static_string(const std::basic_string_view<Symbol>& string)
+            : m_string(string)
+        {
+        }
+
+        template <class ParseContext>
+        parse_result parse(ParseContext& pc) const {
+            return parse_string(pc, m_string.data(), m_string.size());
+        }
+
+        template <class ParseContext>
+        bool analyze(grammar_analysis<ParseContext>& analysis) const {
+            return m_string.empty() || analysis.analyze_symbol(m_string.front());
+        }
+
+    private:
+        std::basic_string_view<Symbol> m_string;
+    };
+
+
+    template <class ParseContext, class Symbol>
+    class static_set : public static_expression {
+    public:
+        static_set(const std::basic_string_view<Symbol>& set)
+            : m_set(set)
+        {
+        }
+
+        parse_result parse(ParseContext& pc) const {
+            if (pc.is_valid_iterator() && m_set.contains(*pc.get_iterator())) {
+                pc.increment_iterator();
+                return true;
+            }
+            return false;
+        }
+
+        bool analyze(grammar_analysis<ParseContext>& analysis) const {
+            for (const Symbol& symbol : m_set.get_symbols()) {
+                analysis.analyze_symbol(symbol);
+            }
+            return false;
+        }
+
+    private:
+        symbol_set<ParseContext, Symbol> m_set;
+    };
+
+
+    template <class Symbol>
+    class static_range : public static_expression {
+    public:
+        static_range(const Symbol& min, const Symbol& max)
+            : m_min(min)
+            , m_max(max)
+        {
+        }
+
+        template <class ParseContext>
+        parse_result parse(ParseContext& pc) const {
+            if (pc.is_valid_iterator()) {
+                const auto& token = *pc.get_iterator();
+                if (pc.compare(token, m_min) >= 0 && pc.compare(token, m_max) <= 0) {
+                    pc.increment_iterator();
+                    return true;
+                }
+            }
+            return false;
+        }
+
+        template <class ParseContext>
+        bool analyze(grammar_analysis<ParseContext>& analysis) const {
+            return analysis.analyze_range(m_min, m_max);
+        }
+
+    private:
+        Symbol m_min;
+        Symbol m_max;
+    };
+
+
+    class static_any : public static_expression {
+    public:
+        template <class ParseContext>
+        parse_result parse(ParseContext& pc) const {
+            if (pc.is_valid_iterator()) {
+                pc.increment_iterator();
+                return true;
+            }
+            return false;
+        }
+
+        template <class ParseContext>
+        bool analyze(grammar_analysis<ParseContext>& analysis) const {
+            return analysis.analyze_any();
+        }
+    };
+
+
+    class static_end : public static_expression {
+    public:
+        template <class ParseContext>
+        parse_result parse(ParseContext& pc) const {
+            return !pc.is_valid_iterator();
+        }
+
+        template <class ParseContext>
+        bool analyze(grammar_analysis<ParseContext>&) const {
+            return true;
+        }
+    };
+
+
+    class static_bool : public static_expression {
+    public:
+        static_bool(bool value)
+            : m_value(value)
+        {
+        }
+
+        template <class ParseContext>
+        parse_result parse(ParseContext&) const {
+            return m_value;
+        }
+
+        template <class ParseContext>
+        bool analyze(grammar_analysis<ParseContext>&) const {
+            return m_value;
+        }
+
+    private:
+        bool m_value;
+    };
+
+
+    template <class F>
+    class static_function : public static_expression {
+    public:
+        static_function(const F& function)
+            : m_function(function)
+        {
+        }
+
+        template <class ParseContext>
+        parse_result parse(ParseContext& pc) const {
+            return m_function(pc);
+        }
+
+        template <class ParseContext>
+        bool analyze(grammar_analysis<ParseContext>& analysis) const {
+            return analysis.analyze_opaque();
+        }
+
+    private:
+        F m_function;
+    };
+
+
+    template <class ParseContext>
+    class static_ref : public static_expression {
+    public:
+        static_ref(const parse_node_ptr<ParseContext>& parse_node)
+            : m_parse_node(parse_node)
+        {
+        }
+
+        parse_result parse(ParseContext& pc) const {
+            return m_parse_node->parse(pc);
+        }
+
+        bool analyze(grammar_analysis<ParseContext>& analysis) const {
+            return analysis.analyze(m_parse_node.get());
+        }
+
+    private:
+        parse_node_ptr<ParseContext> m_parse_node;
+    };
+
+
+    template <class Left, class Right>
+    class static_sequence : public static_expression {
+    public:
+        static_sequence(const Left& left, const Right& right)
+            : m_left(left)
+            , m_right(right)
+        {
+        }
+
+        template <class ParseContext>
+        parse_result parse(ParseContext& pc) const {
+            const auto base_checkpoint = pc.get_checkpoint();
+            parse_result result = m_left.parse(pc);
+            if (result) {
+                result = m_right.parse(pc);
+                if (result) {
+                    return true;
+                }
+            }
+            pc.restore_checkpoint(base_checkpoint);
+            return result;
+        }
+
+        template <class ParseContext>
+        bool analyze(grammar_analysis<ParseContext>& analysis) const {
+            const bool left_nullable = analysis.analyze_expression(m_left);
+            const bool right_nullable = analysis.analyze_expression(m_right, left_nullable);
+            return left_nullable && right_nullable;
+        }
+
+    private:
+        Left m_left;
+        Right m_right;
+    };
+
+
+    template <class Left, class Right>
+    class static_choice : public static_expression {
+    public:
+        static_choice(const Left& left, const Right& right)
+            : m_left(left)
+            , m_right(right)
+        {
+        }
+
+        template <class ParseContext>
+        parse_result parse(ParseContext& pc) const {
+            const auto base_checkpoint = pc.get_checkpoint();
+            parse_result result = m_left.parse(pc);
+            if (result) {
+                return true;
+            }
+            if (!pc.restore_checkpoint(base_checkpoint) || result.is_left_recursion()) {
+                return result;
+            }
+            result = m_right.parse(pc);
+            if (result) {
+                return true;
+            }
+            pc.restore_checkpoint(base_checkpoint);
+            return result;
+        }
+
+        template <class ParseContext>
+        bool analyze(grammar_analysis<ParseContext>& analysis) const {
+            const bool left_nullable = analysis.analyze_expression(m_left);
+            const bool right_nullable = analysis.analyze_expression(m_right);
+            return left_nullable || right_nullable;
+        }
+
+    private:
+        Left m_left;
+        Right m_right;
+    };
+
+
+    template <class Expression>
+    class static_loop_0 : public static_expression {
+    public:
+        static_loop_0(const Expression& expression)
+            : m_expression(expression)
+        {
+        }
+
+        template <class ParseContext>
+        parse_result parse(ParseContext& pc) const {
+            for (;;) {
+                const auto base_checkpoint = pc.get_checkpoint();
+                const parse_result result = m_expression.parse(pc);
+                if (!result || pc.get_iterator() == base_checkpoint.get_iterator()) {
+                    const bool restored = pc.restore_checkpoint(base_checkpoint);
+                    if (result.is_left_recursion() || (!result && !restored)) {
+                        return result;
+                    }
+                    break;
+                }
+            }
+            return true;
+        }
+
+        template <class ParseContext>
+        bool analyze(grammar_analysis<ParseContext>& analysis) const {
+            analysis.analyze_expression(m_expression);
+            return true;
+        }
+
+    private:
+        Expression m_expression;
+    };
+
+
+    template <class Expression>
+    class static_loop_1 : public static_expression {
+    public:
+        static_loop_1(const Expression& expression)
+            : m_expression(expression)
+        {
+        }
+
+        template <class ParseContext>
+        parse_result parse(ParseContext& pc) const {
+            const parse_result first_result = m_expression.parse(pc);
+            if (!first_result) {
+                return first_result;
+            }
+            for (;;) {
+                const auto base_checkpoint = pc.get_checkpoint();
+                const parse_result result = m_expression.parse(pc);
+                if (!result || pc.get_iterator() == base_checkpoint.get_iterator()) {
+                    const bool restored = pc.restore_checkpoint(base_checkpoint);
+                    if (result.is_left_recursion() || (!result && !restored)) {
+                        return result;
+                    }
+                    break;
+                }
+            }
+            return true;
+        }
+
+        template <class ParseContext>
+        bool analyze(grammar_analysis<ParseContext>& analysis) const {
+            return analysis.analyze_expression(m_expression);
+        }
+
+    private:
+        Expression m_expression;
+    };
+
+
+    template <class Expression>
+    class static_loop_n : public static_expression {
+    public:
+        static_loop_n(const Expression& expression, size_t times)
+            : m_expression(expression)
+            , m_times(times)
+        {
+        }
+
+        template <class ParseContext>
+        parse_result parse(ParseContext& pc) const {
+            const auto base_checkpoint = pc.get_checkpoint();
+            for (size_t count = 0; count < m_times; ++count) {
+                const parse_result result = m_expression.parse(pc);
+                if (!result) {
+                    pc.restore_checkpoint(base_checkpoint);
+                    return result;
+                }
+            }
+            return true;
+        }
+
+        template <class ParseContext>
+        bool analyze(grammar_analysis<ParseContext>& analysis) const {
+            return analysis.analyze_expression(m_expression) || m_times == 0;
+        }
+
+    private:
+        Expression m_expression;
+        size_t m_times;
+    };
+
+
+    template <class Expression>
+    class static_optional : public static_expression {
+    public:
+        static_optional(const Expression& expression)
+            : m_expression(expression)
+        {
+        }
+
+        template <class ParseContext>
+        parse_result parse(ParseContext& pc) const {
+            const auto base_checkpoint = pc.get_checkpoint();
+            const parse_result result = m_expression.parse(pc);
+            if (!result) {
+                if (!pc.restore_checkpoint(base_checkpoint) || result.is_left_recursion()) {
+                    return result;
+                }
+            }
+            return true;
+        }
+
+        template <class ParseContext>
+        bool analyze(grammar_analysis<ParseContext>& analysis) const {
+            analysis.analyze_expression(m_expression);
+            return true;
+        }
+
+    private:
+        Expression m_expression;
+    };
+
+
+    template <class Expression>
+    class static_logical_and : public static_expression {
+    public:
+        static_logical_and(const Expression& expression)
+            : m_expression(expression)
+        {
+        }
+
+        template <class ParseContext>
+        parse_result parse(ParseContext& pc) const {
+            const auto base_checkpoint = pc.get_checkpoint();
+            const size_t cut_scope = pc.begin_cut_scope();
+            const parse_result result = m_expression.parse(pc);
+            pc.end_cut_scope(cut_scope);
+            pc.restore_checkpoint(base_checkpoint);
+            return result;
+        }
+
+        template <class ParseContext>
+        bool analyze(grammar_analysis<ParseContext>& analysis) const {
+            analysis.analyze_expression(m_expression);
+            return true;
+        }
+
+    private:
+        Expression m_expression;
+    };
+
+
+    template <class Expression>
+    class static_logical_not : public static_expression {
+    public:
+        static_logical_not(const Expression& expression)
+            : m_expression(expression)
+        {
+        }
+
+        template <class ParseContext>
+        parse_result parse(ParseContext& pc) const {
+            const auto base_checkpoint = pc.get_checkpoint();
+            const size_t cut_scope = pc.begin_cut_scope();
+            const parse_result result = m_expression.parse(pc);
+            pc.end_cut_scope(cut_scope);
+            pc.restore_checkpoint(base_checkpoint);
+            if (result.is_left_recursion()) {
+                return result;
+            }
+            return !result;
+        }
+
+        template <class ParseContext>
+        bool analyze(grammar_analysis<ParseContext>& analysis) const {
+            analysis.analyze_expression(m_expression);
+            return true;
+        }
+
+    private:
+        Expression m_expression;
+    };
+
+
+    template <class Expression, class Id>
+    class static_match : public static_expression {
+    public:
+        static_match(const Expression& expression, const Id& id)
+            : m_expression(expression)
+            , m_id(id)
+        {
+        }
+
+        template <class ParseContext>
+        parse_result parse(ParseContext& pc) const {
+            const auto from_state = pc.get_match_parse_state();
+            const size_t partition = pc.open_partition(from_state.get_iterator());
+            const parse_result result = m_expression.parse(pc);
+            pc.close_partition(partition);
+            if (result) {
+                pc.add_match(m_id, from_state);
+            }
+            return result;
+        }
+
+        template <class ParseContext>
+        bool analyze(grammar_analysis<ParseContext>& analysis) const {
+            return analysis.analyze_expression(m_expression);
+        }
+
+    private:
+        Expression m_expression;
+        Id m_id;
+    };
+
+
+    template <class Expression, class Id>
+    class static_error : public static_expression {
+    public:
+        static_error(const Expression& expression, const Id& id)
+            : m_expression(expression)
+            , m_id(id)
+        {
+        }
+
+        template <class ParseContext>
+        parse_result parse(ParseContext& pc) const {
+            const auto from_iterator = pc.get_iterator();
+            const size_t partition = pc.open_partition(from_iterator);
+            const parse_result result = m_expression.parse(pc);
+            pc.close_partition(partition);
+            if (result) {
+                pc.add_error(m_id, from_iterator);
+            }
+            return result;
+        }
+
+        template <class ParseContext>
+        bool analyze(grammar_analysis<ParseContext>& analysis) const {
+            return analysis.analyze_expression(m_expression);
+        }
+
+    private:
+        Expression m_expression;
+        Id m_id;
+    };
+
+
+    template <class Expression>
+    class static_newline : public static_expression {
+    public:
+        static_newline(const Expression& expression)
+            : m_expression(expression)
+        {
+        }
+
+        template <class ParseContext>
+        parse_result parse(ParseContext& pc) const {
+            const parse_result result = m_expression.parse(pc);
+            if (result) {
+                pc.increment_line();
+            }
+            return result;
+        }
+
+        template <class ParseContext>
+        bool analyze(grammar_analysis<ParseContext>& analysis) const {
+            return analysis.analyze_expression(m_expression);
+        }
+
+    private:
+        Expression m_expression;
+    };
+
+
+    template <class ParseContext, class Expression>
+    class static_parse_node : public parse_node<ParseContext> {
+    public:
+        static_parse_node(const Expression& expression)
+            : m_expression(expression)
+        {
+        }
+
+        parse_result parse(ParseContext& pc) const override {
+            return m_expression.parse(pc);
+        }
+
+        bool analyze(grammar_analysis<ParseContext>& analysis) const override {
+            return m_expression.analyze(analysis);
+        }
+
+    private:
+        Expression m_expression;
+    };
+
+
+    template <class T>
+    inline constexpr bool is_static_operand_v =
+        is_static_expression_v<T> ||
+        std::is_arithmetic_v<T> ||
+        std::is_enum_v<T> ||
+        (std::is_array_v<T> && std::is_arithmetic_v<std::remove_extent_t<T>>) ||
+        (std::is_pointer_v<T> && std::is_arithmetic_v<std::remove_const_t<std::remove_pointer_t<T>>>);
+
+
+    template <class Left, class Right>
+    inline constexpr bool is_static_binary_operand_v =
+        (is_static_expression_v<Left> && is_static_operand_v<Right>) ||
+        (is_static_operand_v<Left> && is_static_expression_v<Right>);
+
+
+    template <class T>
+    auto make_static_expression(const T& value) {
+        if constexpr (is_static_expression_v<T>) {
+            return value;
+        }
+        else if constexpr (std::is_same_v<T, bool>) {
+            return static_bool(value);
+        }
+        else if constexpr (std::is_array_v<T>) {
+            return static_string<std::remove_extent_t<T>>(value);
+        }
+        else if constexpr (std::is_pointer_v<T>) {
+            return static_string<std::remove_const_t<std::remove_pointer_t<T>>>(value);
+        }
+        else {
+            return static_symbol<T>(value);
+        }
+    }
+
+
+    template <class T>
+    using static_expression_t = decltype(make_static_expression(std::declval<const T&>()));
+
+
+    template <class Iterator = std::string::const_iterator, class MatchId = int, class ErrorId = int, class SymbolComparator = default_symbol_comparator>
+    class static_parser : public parser<Iterator, MatchId, ErrorId, SymbolComparator> {
+    public:
+        using base_parser_type = parser<Iterator, MatchId, ErrorId, SymbolComparator>;
+        using parse_context = typename base_parser_type::parse_context;
+        using parse_node_ptr = typename base_parser_type::parse_node_ptr;
+        using rule = typename base_parser_type::rule;
+
+        using base_parser_type::newline;
+        using base_parser_type::error;
+
+        template <class Symbol>
+        static static_symbol<Symbol> terminal(const Symbol& symbol) {
+            return symbol;
+        }
+
+        template <class Symbol>
+        static static_string<Symbol> terminal(const Symbol* string) {
+            return std::basic_string_view<Symbol>(string);
+        }
+
+        template <class Symbol>
+        static static_set<parse_context, Symbol> set(const Symbol* set) {
+            return std::basic_string_view<Symbol>(set);
+        }
+
+        template <class Symbol>
+        static static_range<Symbol> range(const Symbol& min, const Symbol& max) {
+            return { min, max };
+        }
+
+        static static_any any() {
+            return {};
+        }
+
+        static static_end end() {
+            return {};
+        }
+
+        template <class Expression, std::enable_if_t<is_static_expression_v<Expression>, int> = 0>
+        static static_newline<Expression> newline(const Expression& expression) {
+            return expression;
+        }
+
+        template <class F>
+        static static_function<F> function(const F& func) {
+            return func;
+        }
+
+        template <class Expression, std::enable_if_t<is_static_expression_v<Expression>, int> = 0>
+        static static_error<Expression, ErrorId> error(const ErrorId& id, const Expression& expression) {
+            return { expression, id };
+        }
+
+        static static_ref<parse_context> ref(rule& r) {
+            return parse_node_ptr(r);
+        }
+
+        static static_ref<parse_context> ref(const parse_node_ptr& parse_node) {
+            return parse_node;
+        }
+    };
+
+
+    template <class Expression, std::enable_if_t<is_static_expression_v<Expression>, int> = 0>
+    static_loop_0<Expression> operator *(const Expression& expression) {
+        return expression;
+    }
+
+
+    template <class Expression, std::enable_if_t<is_static_expression_v<Expression>, int> = 0>
+    static_loop_1<Expression> operator +(const Expression& expression) {
+        return expression;
+    }
+
+
+    template <class Expression, std::enable_if_t<is_static_expression_v<Expression>, int> = 0>
+    static_optional<Expression> operator -(const Expression& expression) {
+        return expression;
+    }
+
+
+    template <class Expression, std::enable_if_t<is_static_expression_v<Expression>, int> = 0>
+    static_logical_and<Expression> operator &(const Expression& expression) {
+        return expression;
+    }
+
+
+    template <class Expression, std::enable_if_t<is_static_expression_v<Expression>, int> = 0>
+    static_logical_not<Expression> operator !(const Expression& expression) {
+        return expression;
+    }
+
+
+    template <class Expression, std::enable_if_t<is_static_expression_v<Expression>, int> = 0>
+    static_loop_n<Expression> operator *(size_t times, const Expression& expression) {
+        return { expression, times };
+    }
+
+
+    template <class Expression, std::enable_if_t<is_static_expression_v<Expression>, int> = 0>
+    static_loop_n<Expression> operator *(const Expression& expression, size_t times) {
+        return { expression, times };
+    }
+
+
+    template <class Left, class Right, std::enable_if_t<is_static_binary_operand_v<Left, Right>, int> = 0>
+    static_sequence<static_expression_t<Left>, static_expression_t<Right>> operator >> (const Left& left, const Right& right) {
+        return { make_static_expression(left), make_static_expression(right) };
+    }
+
+
+    template <class Left, class Right, std::enable_if_t<is_static_binary_operand_v<Left, Right>, int> = 0>
+    static_choice<static_expression_t<Left>, static_expression_t<Right>> operator | (const Left& left, const Right& right) {
+        return { make_static_expression(left), make_static_expression(right) };
+    }
+
+
+    template <class Left, class Right, std::enable_if_t<is_static_binary_operand_v<Left, Right>, int> = 0>
+    static_sequence<static_logical_not<static_expression_t<Right>>, static_expression_t<Left>> operator - (const Left& left, const Right& right) {
+        return { make_static_expression(right), make_static_expression(left) };
+    }
+
+
+    template <class Expression, class Id, std::enable_if_t<is_static_expression_v<Expression>, int> = 0>
+    static_match<Expression, Id> operator ->* (const Expression& expression, const Id& id) {
+        return { expression, id };
+    }
+
+
+} //namespace parserlib
+
+
+#endif //PARSERLIB_STATIC_PARSER_HPP
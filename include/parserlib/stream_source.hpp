@@ -0,0 +1,363 @@
+#ifndef PARSERLIB_STREAM_SOURCE_HPP
+#define PARSERLIB_STREAM_SOURCE_HPP
+
+
+#include <deque>
+#include <memory>
+#include <functional>
+#include <istream>
+#include <iterator>
+#include <stdexcept>
+#include <algorithm>
+#include <cstddef>
+#ifdef _WIN32
+#include <io.h>
+#else
+#include <unistd.h>
+#endif
+
+
+namespace parserlib {
+
+
+    class stream_source {
+    public:
+        static constexpr size_t default_chunk_size = 65536;
+
+        class const_iterator {
+        public:
+            using iterator_category = std::forward_iterator_tag;
+            using value_type = char;
+            using difference_type = std::ptrdiff_t;
+            using pointer = const char*;
+            using reference = const char&;
+
+            const_iterator() {
+            }
+
+            const_iterator(const const_iterator& it)
+                : m_source(it.m_source)
+                , m_position(it.m_position)
+                , m_chunk(it.m_chunk)
+                , m_data(it.m_data)
+                , m_data_size(it.m_data_size)
+                , m_pinned(it.m_pinned)
+                , m_end(it.m_end)
+            {
+                pin();
+            }
+
+            ~const_iterator() {
+                unpin();
+            }
+
+            const_iterator& operator = (const const_iterator& it) {
+                it.pin();
+                unpin();
+                m_source = it.m_source;
+                m_position = it.m_position;
+                m_chunk = it.m_chunk;
+                m_data = it.m_data;
+                m_data_size = it.m_data_size;
+                m_pinned = it.m_pinned;
+                m_end = it.m_end;
+                return *this;
+            }
+
+            size_t get_position() const {
+                return m_position;
+            }
+
+            bool is_pinned() const {
+                return m_pinned;
+            }
+
+            reference operator *() const {
+                if (m_data && m_chunk >= m_source->m_first_chunk && m_position - m_chunk * m_source->m_chunk_size < m_data_size) {
+                    return m_data[m_position - m_chunk * m_source->m_chunk_size];
+                }
+                return m_source->get_symbol(m_position);
+            }
+
+            pointer operator ->() const {
+                return &**this;
+            }
+
+            const_iterator& operator ++() {
+                ++m_position;
+                if (m_pinned && m_position - m_chunk * m_source->m_chunk_size >= m_data_size) {
+                    move_to_position();
+                }
+                return *this;
+            }
+
+            const_iterator operator ++(int) {
+                const_iterator result = *this;
+                ++*this;
+                return result;
+            }
+
+            const_iterator& operator += (size_t count) {
+                m_position += count;
+                if (m_pinned && m_position - m_chunk * m_source->m_chunk_size >= m_data_size) {
+                    move_to_position();
+                }
+                return *this;
+            }
+
+            difference_type operator - (const const_iterator& it) const {
+                return static_cast<difference_type>(m_position) - static_cast<difference_type>(it.m_position);
+            }
+
+            bool operator == (const const_iterator& it) const {
+                if (m_end || it.m_end) {
+                    return (m_end && it.m_end) || (m_end ? it.is_at_end() : is_at_end());
+                }
+                return m_position == it.m_position;
+            }
+
+            bool operator != (const const_iterator& it) const {
+                return !operator == (it);
+            }
+
+        private:
+            static constexpr size_t npos = static_cast<size_t>(-1);
+
+            stream_source* m_source{ nullptr };
+            size_t m_position{ 0 };
+            size_t m_chunk{ npos };
+            const char* m_data{ nullptr };
+            size_t m_data_size{ 0 };
+            bool m_pinned{ false };
+            bool m_end{ false };
+
+            const_iterator(const const_iterator& it, bool pinned)
+                : m_source(it.m_source)
+                , m_position(it.m_position)
+                , m_pinned(pinned)
+                , m_end(it.m_end)
+            {
+                if (m_pinned) {
+                    move_to_position();
+                }
+            }
+
+            const_iterator(stream_source* source, bool end)
+                : m_source(source)
+                , m_pinned(!end)
+                , m_end(end)
+            {
+                if (m_pinned) {
+                    move_to_position();
+                }
+            }
+
+            void pin() const {
+                if (m_chunk != npos) {
+                    m_source->pin(m_chunk);
+                }
+            }
+
+            void unpin() {
+                if (m_chunk != npos) {
+                    m_source->unpin(m_chunk);
+                }
+            }
+
+            void move_to_position() {
+                const size_t prev_chunk = m_chunk;
+                const size_t chunk = m_position / m_source->m_chunk_size;
+                if (m_source->load(chunk)) {
+                    m_chunk = chunk;
+                    m_source->pin(m_chunk);
+                    m_data = m_source->get_chunk(m_chunk).m_data.get();
+                    m_data_size = m_source->get_chunk(m_chunk).m_size;
+                }
+                else {
+                    m_chunk = npos;
+                    m_data = nullptr;
+                    m_data_size = 0;
+                }
+                if (prev_chunk != npos) {
+                    m_source->unpin(prev_chunk);
+                }
+            }
+
+            bool is_at_end() const {
+                if (m_data && m_chunk >= m_source->m_first_chunk && m_position - m_chunk * m_source->m_chunk_size < m_data_size) {
+                    return false;
+                }
+                return !m_source || !m_source->is_valid_position(m_position);
+            }
+
+            friend class stream_source;
+        };
+
+        using iterator = const_iterator;
+
+        stream_source(std::istream& stream, size_t chunk_size = default_chunk_size)
+            : m_read([&stream](char* data, size_t size) {
+                stream.read(data, static_cast<std::streamsize>(size));
+                return static_cast<size_t>(stream.gcount());
+            })
+            , m_chunk_size(chunk_size)
+        {
+        }
+
+        stream_source(int file_descriptor, size_t chunk_size = default_chunk_size)
+            : m_read([file_descriptor](char* data, size_t size) {
+#ifdef _WIN32
+                const int count = _read(file_descriptor, data, static_cast<unsigned>(size));
+#else
+                const auto count = ::read(file_descriptor, data, size);
+#endif
+                return count > 0 ? static_cast<size_t>(count) : 0;
+            })
+            , m_chunk_size(chunk_size)
+        {
+        }
+
+        stream_source(const stream_source&) = delete;
+
+        stream_source& operator = (const stream_source&) = delete;
+
+        const_iterator begin() const {
+            return const_iterator(const_cast<stream_source*>(this), false);
+        }
+
+        const_iterator end() const {
+            return const_iterator(const_cast<stream_source*>(this), true);
+        }
+
+        size_t get_chunk_size() const {
+            return m_chunk_size;
+        }
+
+        size_t get_buffered_chunk_count() const {
+            return m_chunks.size();
+        }
+
+        size_t get_max_buffered_chunk_count() const {
+            return m_max_buffered_chunk_count;
+        }
+
+        size_t get_released_chunk_count() const {
+            return m_first_chunk;
+        }
+
+        static const_iterator make_weak_iterator(const const_iterator& it) {
+            return const_iterator(it, false);
+        }
+
+        static void commit_iterator(const const_iterator& it) {
+            if (it.m_source) {
+                it.m_source->release(it.m_position / it.m_source->m_chunk_size);
+            }
+        }
+
+    private:
+        struct chunk {
+            std::unique_ptr<char[]> m_data;
+            size_t m_size{ 0 };
+            size_t m_pin_count{ 0 };
+        };
+
+        std::function<size_t(char*, size_t)> m_read;
+        size_t m_chunk_size;
+        std::deque<chunk> m_chunks;
+        size_t m_first_chunk{ 0 };
+        size_t m_max_buffered_chunk_count{ 0 };
+        bool m_eof{ false };
+
+        chunk& get_chunk(size_t index) {
+            return m_chunks[index - m_first_chunk];
+        }
+
+        bool load(size_t index) {
+            if (index < m_first_chunk) {
+                throw std::out_of_range("stream_source: chunk already released");
+            }
+            while (index >= m_first_chunk + m_chunks.size()) {
+                if (m_eof) {
+                    return false;
+                }
+                chunk new_chunk;
+                new_chunk.m_data = std::make_unique<char[]>(m_chunk_size);
+                while (new_chunk.m_size < m_chunk_size) {
+                    const size_t count = m_read(new_chunk.m_data.get() + new_chunk.m_size, m_chunk_size - new_chunk.m_size);
+                    if (count == 0) {
+                        m_eof = true;
+                        break;
+                    }
+                    new_chunk.m_size += count;
+                }
+                if (new_chunk.m_size == 0) {
+                    return false;
+                }
+                m_chunks.push_back(std::move(new_chunk));
+                m_max_buffered_chunk_count = std::max(m_max_buffered_chunk_count, m_chunks.size());
+            }
+            return true;
+        }
+
+        bool is_valid_position(size_t position) {
+            const size_t index = position / m_chunk_size;
+            if (index < m_first_chunk) {
+                return true;
+            }
+            return load(index) && position - index * m_chunk_size < get_chunk(index).m_size;
+        }
+
+        const char& get_symbol(size_t position) {
+            const size_t index = position / m_chunk_size;
+            if (!load(index) || position - index * m_chunk_size >= get_chunk(index).m_size) {
+                throw std::out_of_range("stream_source: position past the end of the stream");
+            }
+            return get_chunk(index).m_data[position - index * m_chunk_size];
+        }
+
+        void release(size_t index) {
+            while (!m_chunks.empty() && m_first_chunk < index) {
+                m_chunks.pop_front();
+                ++m_first_chunk;
+            }
+        }
+
+        void pin(size_t index) {
+            if (index >= m_first_chunk) {
+                ++get_chunk(index).m_pin_count;
+            }
+        }
+
+        void unpin(size_t index) {
+            if (index < m_first_chunk) {
+                return;
+            }
+            --get_chunk(index).m_pin_count;
+            while (!m_chunks.empty() && m_chunks.front().m_pin_count == 0) {
+                m_chunks.pop_front();
+                ++m_first_chunk;
+            }
+        }
+    };
+
+
+    inline stream_source::const_iterator make_weak_iterator(const stream_source::const_iterator& it) {
+        return stream_source::make_weak_iterator(it);
+    }
+
+
+    inline void commit_iterator(const stream_source::const_iterator& it) {
+        stream_source::commit_iterator(it);
+    }
+
+
+    inline bool is_iterator_before(const stream_source::const_iterator& a, const stream_source::const_iterator& b) {
+        return a.get_position() < b.get_position();
+    }
+
+
+} //namespace parserlib
+
+
+#endif //PARSERLIB_STREAM_SOURCE_HPP
@@ -0,0 +1,124 @@
+#ifndef PARSERLIB_STRING_COMPARE_HPP
+#define PARSERLIB_STRING_COMPARE_HPP
+
+
+#include <cstddef>
+#include <cstring>
+#include <iterator>
+#include <type_traits>
+#include "contiguous_iterator.hpp"
+#include "parse_context.hpp"
+#include "simd.hpp"
+
+
+namespace parserlib {
+
+
+    template <class Symbol>
+    inline constexpr bool is_char_symbol_v =
+        std::is_same_v<Symbol, char> ||
+        std::is_same_v<Symbol, signed char> ||
+        std::is_same_v<Symbol, unsigned char> ||
+        std::is_same_v<Symbol, wchar_t> ||
+        std::is_same_v<Symbol, char16_t> ||
+        std::is_same_v<Symbol, char32_t>;
+
+
+    template <class SymbolComparator, bool Folded = false, class Token, class Symbol>
+    bool equal_symbols(const Token& token, const Symbol& symbol) {
+        if constexpr (has_symbol_fold_v<SymbolComparator>) {
+            const int key = Folded ? static_cast<int>(symbol) : SymbolComparator::fold(static_cast<int>(symbol));
+            return SymbolComparator::fold(static_cast<int>(token)) == key;
+        }
+        else {
+            return SymbolComparator::compare(token, symbol) == 0;
+        }
+    }
+
+
+    template <class Symbol>
+    bool equal_strings_case_insensitive(const Symbol* l, const Symbol* r, size_t size) {
+        size_t index = 0;
+#ifdef PARSERLIB_SSE2
+        if constexpr (sizeof(Symbol) == 1) {
+            const __m128i before_a = _mm_set1_epi8('A' - 1);
+            const __m128i after_z = _mm_set1_epi8('Z' + 1);
+            const __m128i case_bit = _mm_set1_epi8(0x20);
+            const auto fold = [&](__m128i v) {
+                const __m128i upper = _mm_and_si128(_mm_cmpgt_epi8(v, before_a), _mm_cmplt_epi8(v, after_z));
+                return _mm_or_si128(v, _mm_and_si128(upper, case_bit));
+            };
+            for (; index + 16 <= size; index += 16) {
+                const __m128i vl = _mm_loadu_si128(reinterpret_cast<const __m128i*>(l + index));
+                const __m128i vr = _mm_loadu_si128(reinterpret_cast<const __m128i*>(r + index));
+                if (_mm_movemask_epi8(_mm_cmpeq_epi8(fold(vl), fold(vr))) != 0xFFFF) {
+                    return false;
+                }
+            }
+        }
+#endif
+        for (; index < size; ++index) {
+            if (!equal_symbols<case_insensitive_symbol_comparator>(l[index], r[index])) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+
+    template <class SymbolComparator, bool Folded = false, class Symbol>
+    bool equal_strings(const Symbol* l, const Symbol* r, size_t size) {
+        if constexpr (std::is_same_v<SymbolComparator, default_symbol_comparator>) {
+            return std::memcmp(l, r, size * sizeof(Symbol)) == 0;
+        }
+        else if constexpr (std::is_same_v<SymbolComparator, case_insensitive_symbol_comparator>) {
+            return equal_strings_case_insensitive(l, r, size);
+        }
+        else {
+            for (size_t index = 0; index < size; ++index) {
+                if (!equal_symbols<SymbolComparator, Folded>(l[index], r[index])) {
+                    return false;
+                }
+            }
+            return true;
+        }
+    }
+
+
+    template <bool Folded = false, class ParseContext, class Symbol>
+    parse_result parse_string(ParseContext& pc, const Symbol* string, size_t size) {
+        using iterator_type = typename ParseContext::iterator_type;
+        using symbol_comparator_type = typename ParseContext::symbol_comparator_type;
+        if constexpr ((is_contiguous_iterator_v<iterator_type> || is_segmented_iterator_v<iterator_type>) && is_char_symbol_v<Symbol> &&
+            std::is_same_v<std::remove_cv_t<typename std::iterator_traits<iterator_type>::value_type>, Symbol>)
+        {
+            const iterator_type& it = pc.get_iterator();
+            if (get_segment_size(it, pc.get_end_iterator()) >= size) {
+                if (size > 0) {
+                    const Symbol* src = get_iterator_address(it);
+                    if (!equal_symbols<symbol_comparator_type, Folded>(*src, *string) || !equal_strings<symbol_comparator_type, Folded>(src + 1, string + 1, size - 1)) {
+                        return false;
+                    }
+                }
+                pc.increment_iterator(size);
+                return true;
+            }
+            if constexpr (!is_segmented_iterator_v<iterator_type>) {
+                return false;
+            }
+        }
+        auto itSrc = pc.get_iterator();
+        for (size_t index = 0; index < size; ++index, ++itSrc) {
+            if (itSrc == pc.get_end_iterator() || !equal_symbols<symbol_comparator_type, Folded>(*itSrc, string[index])) {
+                return false;
+            }
+        }
+        pc.increment_iterator(size);
+        return true;
+    }
+
+
+} //namespace parserlib
+
+
+#endif //PARSERLIB_STRING_COMPARE_HPP
@@ -2,8 +2,12 @@
 #define PARSERLIB_STRING_PARSE_NODE_HPP
 
 
+#include <string>
 #include <string_view>
+#include <vector>
+#include <type_traits>
 #include "parse_node_ptr.hpp"
+#include "string_compare.hpp"
 
 
 namespace parserlib {
@@ -12,30 +16,47 @@ namespace parserlib {
     template <class ParseContext, class Symbol>
     class string_parse_node : public parse_node<ParseContext> {
     public:
+        static constexpr bool is_folded = has_symbol_fold_v<typename ParseContext::symbol_comparator_type>;
+
         string_parse_node(const std::basic_string_view<Symbol>& string) 
             : m_string(string)
         {
+            if constexpr (is_folded) {
+                for (const Symbol& symbol : m_string) {
+                    m_folded_string.push_back(static_cast<Symbol>(ParseContext::symbol_comparator_type::fold(static_cast<int>(symbol))));
+                }
+            }
         }
 
-        bool parse(ParseContext& pc) const override {
-            auto itStr = m_string.begin();
-            auto itSrc = pc.get_iterator();
-            for (;;) {
-                if (itStr == m_string.end()) {
-                    pc.increment_iterator(m_string.size());
-                    return true;
-                }
-                if (itSrc == pc.get_end_iterator() || pc.compare(*itSrc, *itStr) != 0) {
-                    break;
-                }
-                ++itStr;
-                ++itSrc;
+        const std::basic_string<Symbol>& get_string() const {
+            return m_string;
+        }
+
+        parse_result parse(ParseContext& pc) const override {
+            if constexpr (is_folded) {
+                return parse_string<true>(pc, m_folded_string.data(), m_folded_string.size());
+            }
+            else {
+                return parse_string(pc, m_string.data(), m_string.size());
+            }
+        }
+
+        bool analyze(grammar_analysis<ParseContext>& analysis) const override {
+            return m_string.empty() || analysis.analyze_symbol(m_string.front());
+        }
+
+        void compile(bytecode_compiler<ParseContext>& compiler) const override {
+            if constexpr (std::is_integral_v<Symbol> || std::is_enum_v<Symbol>) {
+                compiler.compile_string(std::vector<int>(m_string.begin(), m_string.end()));
+            }
+            else {
+                compiler.compile_parse_node(this);
             }
-            return false;
         }
 
     private:
-        std::basic_string_view<Symbol> m_string;
+        std::basic_string<Symbol> m_string;
+        std::basic_string<Symbol> m_folded_string;
     };
 
 
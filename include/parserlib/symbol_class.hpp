@@ -0,0 +1,131 @@
+#ifndef PARSERLIB_SYMBOL_CLASS_HPP
+#define PARSERLIB_SYMBOL_CLASS_HPP
+
+
+#include <bitset>
+#include <vector>
+#include <utility>
+#include <algorithm>
+#include <cstring>
+#include "simd.hpp"
+
+
+namespace parserlib {
+
+
+    class symbol_class {
+    public:
+        static constexpr size_t max_vector_range_count = 4;
+
+        symbol_class() {
+        }
+
+        symbol_class(const std::bitset<256>& symbols)
+            : m_symbols(symbols)
+        {
+            for (size_t index = 0; index < m_symbols.size();) {
+                if (!m_symbols[index]) {
+                    ++index;
+                    continue;
+                }
+                const size_t first = index;
+                while (index < m_symbols.size() && m_symbols[index]) {
+                    ++index;
+                }
+                m_ranges.emplace_back(static_cast<unsigned char>(first), static_cast<unsigned char>(index - 1));
+            }
+            if (m_ranges.size() <= 2 && m_symbols.count() == m_symbols.size() - 1) {
+                for (size_t index = 0; index < m_symbols.size(); ++index) {
+                    if (!m_symbols[index]) {
+                        m_excluded_symbol = static_cast<int>(index);
+                        break;
+                    }
+                }
+            }
+        }
+
+        const std::bitset<256>& get_symbols() const {
+            return m_symbols;
+        }
+
+        template <class Symbol>
+        bool contains(const Symbol& symbol) const {
+            return m_symbols[static_cast<unsigned char>(symbol)];
+        }
+
+        size_t scan(const unsigned char* data, size_t size) const {
+            if (m_excluded_symbol >= 0) {
+                const void* found = std::memchr(data, m_excluded_symbol, size);
+                return found ? static_cast<size_t>(static_cast<const unsigned char*>(found) - data) : size;
+            }
+            size_t index = 0;
+#ifdef PARSERLIB_SSE2
+            if (m_ranges.size() <= max_vector_range_count) {
+                for (; index + 16 <= size; index += 16) {
+                    const unsigned mask = get_block_mask(data + index);
+                    if (mask != 0xFFFF) {
+                        return index + count_trailing_zeros(~mask);
+                    }
+                }
+            }
+#endif
+            while (index < size && m_symbols[data[index]]) {
+                ++index;
+            }
+            return index;
+        }
+
+        size_t scan_padded(const unsigned char* data, size_t size) const {
+            if (m_excluded_symbol >= 0) {
+                return scan(data, size);
+            }
+            size_t index = 0;
+#ifdef PARSERLIB_SSE2
+            if (m_ranges.size() <= max_vector_range_count) {
+                for (; index + 16 <= size; index += 16) {
+                    const unsigned mask = get_block_mask(data + index);
+                    if (mask != 0xFFFF) {
+                        return index + count_trailing_zeros(~mask);
+                    }
+                }
+                if (index < size) {
+                    return std::min(index + count_trailing_zeros(~get_block_mask(data + index)), size);
+                }
+                return size;
+            }
+#endif
+            for (; index < size; index += 8) {
+                for (size_t offset = 0; offset < 8; ++offset) {
+                    if (!m_symbols[data[index + offset]]) {
+                        return std::min(index + offset, size);
+                    }
+                }
+            }
+            return size;
+        }
+
+    private:
+        std::bitset<256> m_symbols;
+        std::vector<std::pair<unsigned char, unsigned char>> m_ranges;
+        int m_excluded_symbol{ -1 };
+
+#ifdef PARSERLIB_SSE2
+        unsigned get_block_mask(const unsigned char* data) const {
+            const __m128i zero = _mm_setzero_si128();
+            const __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data));
+            __m128i in_class = zero;
+            for (const auto& [min, max] : m_ranges) {
+                const __m128i offset = _mm_sub_epi8(chunk, _mm_set1_epi8(static_cast<char>(min)));
+                const __m128i excess = _mm_subs_epu8(offset, _mm_set1_epi8(static_cast<char>(max - min)));
+                in_class = _mm_or_si128(in_class, _mm_cmpeq_epi8(excess, zero));
+            }
+            return static_cast<unsigned>(_mm_movemask_epi8(in_class));
+        }
+#endif
+    };
+
+
+} //namespace parserlib
+
+
+#endif //PARSERLIB_SYMBOL_CLASS_HPP
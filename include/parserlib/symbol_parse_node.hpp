@@ -2,7 +2,9 @@
 #define PARSERLIB_SYMBOL_PARSE_NODE_HPP
 
 
+#include <type_traits>
 #include "parse_node_ptr.hpp"
+#include "parse_context.hpp"
 
 
 namespace parserlib {
@@ -11,15 +13,30 @@ namespace parserlib {
     template <class ParseContext, class Symbol>
     class symbol_parse_node : public parse_node<ParseContext> {
     public:
+        static constexpr bool is_folded = has_symbol_fold_v<typename ParseContext::symbol_comparator_type>;
+
         symbol_parse_node(const Symbol& symbol) 
             : m_symbol(symbol)
         {
+            if constexpr (is_folded) {
+                m_folded_symbol = ParseContext::symbol_comparator_type::fold(static_cast<int>(symbol));
+            }
+        }
+
+        const Symbol& get_symbol() const {
+            return m_symbol;
         }
 
-        bool parse(ParseContext& pc) const override {
+        parse_result parse(ParseContext& pc) const override {
             if (pc.is_valid_iterator()) {
                 const auto& token = *pc.get_iterator();
-                if (pc.compare(token, m_symbol) == 0) {
+                if constexpr (is_folded) {
+                    if (ParseContext::symbol_comparator_type::fold(static_cast<int>(token)) == m_folded_symbol) {
+                        pc.increment_iterator();
+                        return true;
+                    }
+                }
+                else if (pc.compare(token, m_symbol) == 0) {
                     pc.increment_iterator();
                     return true;
                 }
@@ -27,16 +44,34 @@ namespace parserlib {
             return false;
         }
 
+        bool analyze(grammar_analysis<ParseContext>& analysis) const override {
+            return analysis.analyze_symbol(m_symbol);
+        }
+
+        void compile(bytecode_compiler<ParseContext>& compiler) const override {
+            if constexpr (std::is_integral_v<Symbol> || std::is_enum_v<Symbol>) {
+                compiler.compile_symbol(static_cast<int>(m_symbol));
+            }
+            else {
+                compiler.compile_parse_node(this);
+            }
+        }
+
     private:
         Symbol m_symbol;
+        int m_folded_symbol{ 0 };
     };
 
 
     template <class ParseContext>
     template <class Symbol>
-    parse_node_ptr<ParseContext>::parse_node_ptr(const Symbol& symbol)
-        : m_parse_node(std::make_shared<symbol_parse_node<ParseContext, Symbol>>(symbol))
-    {
+    parse_node_ptr<ParseContext>::parse_node_ptr(const Symbol& symbol) {
+        if constexpr (std::is_base_of_v<static_expression, Symbol>) {
+            m_parse_node = std::make_shared<static_parse_node<ParseContext, Symbol>>(symbol);
+        }
+        else {
+            m_parse_node = std::make_shared<symbol_parse_node<ParseContext, Symbol>>(symbol);
+        }
     }
 
 
@@ -0,0 +1,123 @@
+#ifndef PARSERLIB_SYMBOL_SET_HPP
+#define PARSERLIB_SYMBOL_SET_HPP
+
+
+#include <string_view>
+#include <vector>
+#include <algorithm>
+#include <limits>
+#include <iterator>
+#include <type_traits>
+#include <cstdint>
+#include "parse_context.hpp"
+
+
+namespace parserlib {
+
+
+    template <class ParseContext, class Symbol>
+    class symbol_set {
+    public:
+        using token_type = typename std::iterator_traits<typename ParseContext::iterator_type>::value_type;
+        using symbol_comparator_type = typename ParseContext::symbol_comparator_type;
+
+        static constexpr bool is_keyed = (std::is_integral_v<Symbol> || std::is_enum_v<Symbol>) && is_keyed_symbol_comparator_v<symbol_comparator_type>;
+
+        symbol_set(const std::basic_string_view<Symbol>& set)
+            : symbol_set(set.begin(), set.end())
+        {
+        }
+
+        template <class It>
+        symbol_set(It begin, It end)
+            : m_symbols(begin, end)
+        {
+            std::sort(m_symbols.begin(), m_symbols.end());
+
+            if constexpr (std::is_integral_v<token_type> && sizeof(token_type) == 1) {
+                m_min_symbol = std::numeric_limits<token_type>::min();
+                m_bit_count = static_cast<size_t>(1) << 8;
+                m_bits.resize(m_bit_count / 64);
+                for (size_t index = 0; index < m_bit_count; ++index) {
+                    const token_type token = static_cast<token_type>(m_min_symbol + static_cast<int>(index));
+                    for (const Symbol& symbol : m_symbols) {
+                        if (ParseContext::compare(token, symbol) == 0) {
+                            set_bit(index);
+                            break;
+                        }
+                    }
+                }
+            }
+
+            else if constexpr (is_keyed) {
+                for (const Symbol& symbol : m_symbols) {
+                    m_keys.push_back(get_symbol_key<symbol_comparator_type>(symbol));
+                }
+                std::sort(m_keys.begin(), m_keys.end());
+                m_keys.erase(std::unique(m_keys.begin(), m_keys.end()), m_keys.end());
+                if (m_keys.empty() || static_cast<long long>(m_keys.back()) - m_keys.front() >= max_dense_set_size) {
+                    return;
+                }
+                m_min_symbol = m_keys.front();
+                m_bit_count = static_cast<size_t>(m_keys.back() - m_keys.front() + 1);
+                m_bits.resize((m_bit_count + 63) / 64);
+                for (const int key : m_keys) {
+                    set_bit(static_cast<size_t>(key - m_min_symbol));
+                }
+            }
+        }
+
+        const std::vector<Symbol>& get_symbols() const {
+            return m_symbols;
+        }
+
+        bool is_dense() const {
+            return !m_bits.empty();
+        }
+
+        bool contains(const token_type& token) const {
+            if constexpr (std::is_integral_v<token_type> && sizeof(token_type) == 1) {
+                const size_t index = static_cast<size_t>(static_cast<int>(token) - m_min_symbol);
+                return (m_bits[index >> 6] >> (index & 63)) & 1;
+            }
+
+            else if constexpr (is_keyed) {
+                const int key = get_symbol_key<symbol_comparator_type>(token);
+                if (!m_bits.empty()) {
+                    const size_t index = static_cast<size_t>(key - m_min_symbol);
+                    return index < m_bit_count && ((m_bits[index >> 6] >> (index & 63)) & 1);
+                }
+                return std::binary_search(m_keys.begin(), m_keys.end(), key);
+            }
+
+            else {
+                auto it = std::upper_bound(m_symbols.begin(), m_symbols.end(), token, [](const auto& a, const auto& b) {
+                    return ParseContext::compare(a, b) < 0;
+                });
+                if (it != m_symbols.begin()) {
+                    --it;
+                    return ParseContext::compare(token, *it) == 0;
+                }
+                return false;
+            }
+        }
+
+    private:
+        static constexpr long long max_dense_set_size = 4096;
+
+        std::vector<Symbol> m_symbols;
+        std::vector<int> m_keys;
+        std::vector<std::uint64_t> m_bits;
+        size_t m_bit_count{ 0 };
+        int m_min_symbol{ 0 };
+
+        void set_bit(size_t index) {
+            m_bits[index >> 6] |= static_cast<std::uint64_t>(1) << (index & 63);
+        }
+    };
+
+
+} //namespace parserlib
+
+
+#endif //PARSERLIB_SYMBOL_SET_HPP
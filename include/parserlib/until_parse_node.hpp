@@ -0,0 +1,211 @@
+#ifndef PARSERLIB_UNTIL_PARSE_NODE_HPP
+#define PARSERLIB_UNTIL_PARSE_NODE_HPP
+
+
+#include <bitset>
+#include <string>
+#include <string_view>
+#include <optional>
+#include <iterator>
+#include <algorithm>
+#include <type_traits>
+#include "parse_node_ptr.hpp"
+#include "contiguous_iterator.hpp"
+#include "symbol_class.hpp"
+#include "string_compare.hpp"
+
+
+namespace parserlib {
+
+
+    enum class until_terminator {
+        exclude,
+        include
+    };
+
+
+    template <class ParseContext, class Symbol>
+    class until_parse_node : public parse_node<ParseContext> {
+    public:
+        using iterator_type = typename ParseContext::iterator_type;
+        using token_type = typename std::iterator_traits<iterator_type>::value_type;
+        using symbol_comparator_type = typename ParseContext::symbol_comparator_type;
+
+        static constexpr bool is_folded = has_symbol_fold_v<symbol_comparator_type>;
+
+        static constexpr bool is_scanned = is_contiguous_iterator_v<iterator_type> && is_char_symbol_v<Symbol> &&
+            sizeof(Symbol) == 1 && std::is_same_v<std::remove_cv_t<token_type>, Symbol>;
+
+        until_parse_node(const std::basic_string_view<Symbol>& terminator, until_terminator mode = until_terminator::exclude)
+            : m_terminator(terminator)
+            , m_mode(mode)
+        {
+            initialize();
+        }
+
+        until_parse_node(const std::basic_string_view<Symbol>& terminator, const Symbol& escape, until_terminator mode = until_terminator::exclude)
+            : m_terminator(terminator)
+            , m_escape(escape)
+            , m_mode(mode)
+        {
+            initialize();
+        }
+
+        const std::basic_string<Symbol>& get_terminator() const {
+            return m_terminator;
+        }
+
+        const std::optional<Symbol>& get_escape() const {
+            return m_escape;
+        }
+
+        until_terminator get_mode() const {
+            return m_mode;
+        }
+
+        parse_result parse(ParseContext& pc) const override {
+            if (m_key.empty()) {
+                return true;
+            }
+
+            size_t count = 0;
+            bool found;
+            if constexpr (is_scanned) {
+                const size_t size = static_cast<size_t>(pc.get_end_iterator() - pc.get_iterator());
+                if constexpr (is_padded_iterator_v<iterator_type>) {
+                    found = find<true>(get_iterator_address(pc.get_iterator()), size, count);
+                }
+                else {
+                    found = size > 0 && find<false>(get_iterator_address(pc.get_iterator()), size, count);
+                }
+                if (!found) {
+                    count = size;
+                }
+            }
+            else {
+                found = find(pc.get_iterator(), pc.get_end_iterator(), count);
+            }
+
+            if (found) {
+                pc.increment_iterator(m_mode == until_terminator::include ? count + m_key.size() : count);
+                return true;
+            }
+            if (m_mode == until_terminator::include) {
+                return false;
+            }
+            pc.increment_iterator(count);
+            return true;
+        }
+
+        bool analyze(grammar_analysis<ParseContext>& analysis) const override {
+            analysis.analyze_any();
+            return m_mode == until_terminator::exclude || m_key.empty();
+        }
+
+        void compile(bytecode_compiler<ParseContext>& compiler) const override {
+            compiler.compile_parse_node(this);
+        }
+
+    private:
+        std::basic_string<Symbol> m_terminator;
+        std::optional<Symbol> m_escape;
+        until_terminator m_mode;
+        std::basic_string<Symbol> m_key;
+        std::optional<Symbol> m_escape_key;
+        symbol_class m_scanned_symbols;
+
+        static Symbol get_key(const Symbol& symbol) {
+            if constexpr (is_folded) {
+                return static_cast<Symbol>(symbol_comparator_type::fold(static_cast<int>(symbol)));
+            }
+            else {
+                return symbol;
+            }
+        }
+
+        void initialize() {
+            for (const Symbol& symbol : m_terminator) {
+                m_key.push_back(get_key(symbol));
+            }
+            if (m_escape) {
+                m_escape_key = get_key(*m_escape);
+            }
+
+            if constexpr (is_scanned) {
+                if (!m_key.empty()) {
+                    std::bitset<256> symbols;
+                    for (size_t index = 0; index < symbols.size(); ++index) {
+                        symbols[index] = !is_stop_symbol(static_cast<Symbol>(index));
+                    }
+                    m_scanned_symbols = symbol_class(symbols);
+                }
+            }
+        }
+
+        template <class Token>
+        bool is_escape(const Token& token) const {
+            return m_escape_key && equal_symbols<symbol_comparator_type, true>(token, *m_escape_key);
+        }
+
+        template <class Token>
+        bool is_stop_symbol(const Token& token) const {
+            return equal_symbols<symbol_comparator_type, true>(token, m_key.front()) || is_escape(token);
+        }
+
+        template <bool Padded>
+        bool find(const Symbol* data, size_t size, size_t& count) const {
+            for (size_t index = 0;;) {
+                if constexpr (Padded) {
+                    index += m_scanned_symbols.scan_padded(reinterpret_cast<const unsigned char*>(data + index), size - index);
+                }
+                else {
+                    index += m_scanned_symbols.scan(reinterpret_cast<const unsigned char*>(data + index), size - index);
+                }
+                if (index == size) {
+                    return false;
+                }
+                if (is_escape(data[index])) {
+                    index = std::min(index + 2, size);
+                    continue;
+                }
+                if (size - index >= m_key.size() && equal_strings<symbol_comparator_type, true>(data + index, m_key.data(), m_key.size())) {
+                    count = index;
+                    return true;
+                }
+                ++index;
+            }
+        }
+
+        bool find(iterator_type it, const iterator_type& end, size_t& count) const {
+            for (; it != end; ++it, ++count) {
+                if (is_escape(*it)) {
+                    if (++it == end) {
+                        ++count;
+                        break;
+                    }
+                    ++count;
+                    continue;
+                }
+                if (is_terminator(it, end)) {
+                    return true;
+                }
+            }
+            return false;
+        }
+
+        bool is_terminator(iterator_type it, const iterator_type& end) const {
+            for (const Symbol& symbol : m_key) {
+                if (it == end || !equal_symbols<symbol_comparator_type, true>(*it, symbol)) {
+                    return false;
+                }
+                ++it;
+            }
+            return true;
+        }
+    };
+
+
+} //namespace parserlib
+
+
+#endif //PARSERLIB_UNTIL_PARSE_NODE_HPP
@@ -1,7 +1,19 @@
 #include <cassert>
 #include <functional>
 #include <sstream>
+#include <tuple>
+#include <deque>
+#include <cstdio>
+#include <fstream>
+#include <filesystem>
+#include <system_error>
+#include <cstdlib>
+#include <limits>
 #include "parserlib.hpp"
+#include "parserlib/mapped_source.hpp"
+#include "parserlib/stream_source.hpp"
+#include "parserlib/segmented_source.hpp"
+#include "parserlib/padded_source.hpp"
 
 
 using namespace parserlib;
@@ -52,6 +64,69 @@ static void test_parse_string() {
 }
 
 
+static void test_parse_string_contiguous() {
+    {
+        const auto grammar = p::terminal("abcdef");
+        std::string src = "abc";
+        p::parse_context pc(src);
+        assert(!grammar.parse(pc));
+        assert(pc.get_iterator() == src.begin());
+    }
+
+    {
+        using p = parser<std::u32string::const_iterator>;
+        const auto grammar = p::terminal(U"\u03b1\u03b2\u03b3") >> p::end();
+        std::u32string src = U"\u03b1\u03b2\u03b3";
+        p::parse_context pc(src);
+        assert(grammar.parse(pc));
+        assert(pc.get_iterator() == src.end());
+    }
+
+    {
+        using p = parser<std::deque<char>::const_iterator>;
+        const auto grammar = p::terminal("abc") >> p::end();
+        std::deque<char> src{ 'a', 'b', 'c' };
+        p::parse_context pc(src);
+        assert(grammar.parse(pc));
+    }
+
+    {
+        using p = parser<text_iterator<>>;
+        const auto grammar = p::terminal("abc") >> p::terminal("def");
+        std::string src = "abcdef";
+        p::parse_context pc(src);
+        assert(grammar.parse(pc));
+        assert(pc.get_iterator().get_column() == 7);
+    }
+
+    {
+        using p = parser<std::string::const_iterator, int, int, case_insensitive_symbol_comparator>;
+        const auto grammar = p::terminal("select_all_records_from_table") >> p::end();
+
+        std::string src1 = "SELECT_ALL_Records_From_TABLE";
+        p::parse_context pc1(src1);
+        assert(grammar.parse(pc1));
+
+        std::string src2 = "SELECT_ALL_Records_From_TABLF";
+        p::parse_context pc2(src2);
+        assert(!grammar.parse(pc2));
+
+        std::string src3 = "SELECT_ALL_Records@From_TABLE";
+        p::parse_context pc3(src3);
+        assert(!grammar.parse(pc3));
+    }
+
+    for (int l = 0; l < 256; ++l) {
+        for (int r = 0; r < 256; ++r) {
+            std::string ls(20, static_cast<char>(l));
+            std::string rs(20, static_cast<char>(r));
+            const bool expected = case_insensitive_symbol_comparator::compare(ls[0], rs[0]) == 0;
+            assert(equal_strings<case_insensitive_symbol_comparator>(ls.data(), rs.data(), ls.size()) == expected);
+        }
+    }
+}
+
+
 static void test_parse_set() {
     const auto grammar = p::set("abc");
 
@@ -89,6 +164,58 @@ static void test_parse_set() {
 }
 
 
+static void test_parse_set_lookup() {
+    {
+        const auto grammar = +p::set("_$\xe9") >> p::end();
+        assert((dynamic_cast<const set_parse_node<p::parse_context, char>*>(p::set("_$\xe9").get())));
+        std::string src = "$\xe9_";
+        p::parse_context pc(src);
+        assert(grammar.parse(pc));
+    }
+
+    {
+        using p = parser<std::string::const_iterator, int, int, case_insensitive_symbol_comparator>;
+        const auto grammar = +p::set("Ab_") >> p::end();
+
+        std::string src1 = "aB_ba";
+        p::parse_context pc1(src1);
+        assert(grammar.parse(pc1));
+
+        std::string src2 = "abc";
+        p::parse_context pc2(src2);
+        assert(!grammar.parse(pc2));
+    }
+
+    {
+        using p = parser<std::u32string::const_iterator>;
+        assert((!symbol_set<p::parse_context, char32_t>(U"a\U0001F600").is_dense()));
+        assert((symbol_set<p::parse_context, char32_t>(U"\u03b1\u03b3").is_dense()));
+
+        const auto grammar = +p::set(U"a\U0001F600") >> p::end();
+        std::u32string src = U"\U0001F600a";
+        p::parse_context pc(src);
+        assert(grammar.parse(pc));
+    }
+
+    {
+        enum { A = 1, B, C, D };
+
+        const auto lexer = *((+p::terminal('a'))->*A | (+p::terminal('b'))->*B | (+p::terminal('c'))->*C | (+p::terminal('d'))->*D);
+        std::string src = "abdbcd";
+        p::parse_context pc(src);
+        assert(lexer.parse(pc));
+
+        using pp = p::derived_parser_type<int, int>;
+        const int ids[] = { D, B, 0 };
+        assert((symbol_set<pp::parse_context, int>(ids).is_dense()));
+        const auto grammar = *(pp::terminal(A) | pp::terminal(C) | pp::set(ids)) >> pp::end();
+
+        auto token_pc = pc.derive_parse_context<int, int>();
+        assert(grammar.parse(token_pc));
+    }
+}
+
+
 static void test_parse_range() {
     const auto grammar = p::range('0', '9');
 
@@ -573,6 +700,92 @@ static void test_parse_match() {
 }
 
 
+static void test_parse_nested_matches() {
+    const auto a = p::terminal('a')->*1;
+    const auto b = p::terminal('b')->*2;
+    const auto inner = (a >> b)->*3;
+    const auto outer = ((inner >> 'x') | (inner >> a))->*4;
+    const auto grammar = *(outer | b);
+
+    {
+        std::string src = "abab";
+        p::parse_context pc(src);
+        const bool ok = grammar.parse(pc);
+        assert(ok);
+        assert(pc.get_iterator() == src.end());
+        assert(pc.get_matches().size() == 2);
+
+        const auto& m0 = pc.get_matches()[0];
+        assert(m0.get_id() == 4);
+        assert(m0.begin() == src.begin());
+        assert(m0.end() == std::next(src.begin(), 3));
+        assert(m0.get_children().size() == 2);
+        assert(m0.get_children()[0].get_id() == 3);
+        assert(m0.get_children()[0].get_children().size() == 2);
+        assert(m0.get_children()[0].get_children()[0].get_id() == 1);
+        assert(m0.get_children()[0].get_children()[1].get_id() == 2);
+        assert(m0.get_children()[1].get_id() == 1);
+        assert(m0.get_children()[1].begin() == std::next(src.begin(), 2));
+
+        const auto& m1 = pc.get_matches()[1];
+        assert(m1.get_id() == 2);
+        assert(m1.get_children().size() == 0);
+
+        std::vector<int> ids;
+        for (const auto& child : m0.get_children()) {
+            ids.push_back(child.get_id());
+        }
+        assert(ids == std::vector<int>({ 3, 1 }));
+        assert(std::prev(m0.get_children().end())->get_id() == 1);
+
+        using pp = p::derived_parser_type<int, int>;
+        const auto token_grammar = pp::terminal(4) >> pp::terminal(2) >> pp::end();
+        auto token_pc = pc.derive_parse_context<int, int>();
+        assert(token_grammar.parse(token_pc));
+    }
+}
+
+
+static void test_matches_outlive_parse_context() {
+    const auto a = p::terminal('a')->*1;
+    const auto b = p::terminal('b')->*2;
+    const auto grammar = *((a >> *b)->*3);
+
+    std::string src = "abbbab";
+    p::parse_context::match_container_type matches;
+
+    {
+        p::parse_context pc(src);
+        assert(grammar.parse(pc));
+        matches = pc.get_matches();
+
+        pc.set_state(p::parse_context::parse_context_state_type(src.begin(), src.end()));
+        assert(pc.get_matches().empty());
+        assert(grammar.parse(pc));
+    }
+
+    assert(matches.size() == 2);
+    const auto children = matches[0].get_children();
+    assert(children.size() == 4);
+    assert(children[0].get_id() == 1);
+    assert(children[3].get_id() == 2);
+    assert(children[3].begin() == std::next(src.begin(), 3));
+    assert(children.end() - children.begin() == 4);
+    assert(children.begin()[2].begin() == std::next(src.begin(), 2));
+    assert(matches[1].get_children().size() == 2);
+    assert(matches[1].get_children().back().begin() == std::next(src.begin(), 5));
+
+    std::vector<int> ids;
+    for (auto it = matches[0].get_children().rbegin(); it != matches[0].get_children().rend(); ++it) {
+        ids.push_back(it->get_id());
+    }
+    assert(ids == std::vector<int>({ 2, 2, 2, 1 }));
+    const auto last = std::make_reverse_iterator(matches[0].get_children().end());
+    assert(last->begin() == std::next(src.begin(), 3));
+    assert(&matches[0].get_children() == &matches[0].get_children());
+}
+
+
 static void test_parse_error() {
     {
         const auto grammar = (p::terminal('a') >> p::terminal(';')) | p::error(1, p::skip_before(';'));
@@ -657,6 +870,51 @@ static void test_parse_case_insensitive() {
 }
 
 
+template <class Parser, class Source>
+static bool parse_all(const parse_node_ptr<typename Parser::parse_context>& grammar, const Source& src) {
+    typename Parser::parse_context pc(src);
+    return grammar.parse(pc) && pc.get_iterator() == src.end();
+}
+
+
+static void test_case_folding() {
+    {
+        using pi = parser<std::string::const_iterator, int, int, case_insensitive_symbol_comparator>;
+        assert(case_insensitive_symbol_comparator::compare('Z', 'z') == 0);
+        assert(case_insensitive_symbol_comparator::compare('\xC9', '\xE9') != 0);
+        assert(case_insensitive_symbol_comparator::compare('[', '{') != 0);
+        assert(parse_all<pi>(pi::terminal("SeLeCt ") >> pi::set("xyz") >> pi::range('a', 'f'), std::string("select Yc")));
+        assert(!parse_all<pi>(pi::terminal("caf\xC9"), std::string("caf\xE9")));
+        assert(parse_all<pi>(pi::terminal("0123456789abcdefghijklmnopqrstuvwxyz"), std::string("0123456789ABCDEFGHIJKLMNOPQRSTUVWXYZ")));
+    }
+
+    {
+        using pl = parser<std::string::const_iterator, int, int, latin1_case_insensitive_symbol_comparator>;
+        assert(latin1_case_insensitive_symbol_comparator::fold(0xC9) == 0xE9);
+        assert(latin1_case_insensitive_symbol_comparator::fold(0xD7) == 0xD7);
+        assert(latin1_case_insensitive_symbol_comparator::fold(0xDF) == 0xDF);
+        assert(latin1_case_insensitive_symbol_comparator::compare('\xC9', '\xE9') == 0);
+        assert(parse_all<pl>(pl::terminal("CAF\xC9"), std::string("caf\xE9")));
+        assert(parse_all<pl>(pl::set("\xC0\xC9"), std::string("\xE9")));
+        assert(!parse_all<pl>(pl::terminal('\xD7'), std::string("\xF7")));
+    }
+
+    {
+        using pu = parser<std::u32string::const_iterator, int, int, unicode_case_insensitive_symbol_comparator>;
+        assert(unicode_case_insensitive_symbol_comparator::fold(0x212A) == 'k');
+        assert(unicode_case_insensitive_symbol_comparator::fold(0x03A3) == 0x03C3);
+        assert(unicode_case_insensitive_symbol_comparator::fold(0x03C2) == 0x03C3);
+        assert(unicode_case_insensitive_symbol_comparator::fold(0x0130) == 0x0130);
+        assert(unicode_case_insensitive_symbol_comparator::fold(0x10400) == 0x10428);
+        assert(unicode_case_insensitive_symbol_comparator::fold(0x4E00) == 0x4E00);
+        assert(parse_all<pu>(pu::terminal(U"\u03A3\u0391\u03A3"), std::u32string(U"\u03C3\u03B1\u03C2")));
+        assert(parse_all<pu>(pu::terminal(U'k') >> pu::set(U"\u00C9\u0416"), std::u32string(U"\u212A\u0436")));
+        assert(parse_all<pu>(pu::range(U'\u0410', U'\u042F'), std::u32string(U"\u0431")));
+        assert(!parse_all<pu>(pu::terminal(U"\u0391"), std::u32string(U"\u03B2")));
+    }
+}
+
+
 static void test_parse_rule() {
     {
         p::rule grammar = 'a';
@@ -878,12 +1136,8 @@ static void test_parse_left_recursion() {
 
     rule_type add, mul;
 
-    auto digit 
-        = p::range('0', '9')
-        ;
-
     auto num 
-        = (-p::terminal('-') >> +digit >> -('.' >> +digit))->*NUM
+        = p::decimal(number_sign::minus)->*NUM
         ;
 
     auto val 
@@ -918,13 +1172,8 @@ static void test_parse_left_recursion() {
 
     eval = [&](const match_type& match) {
         switch (match.get_id()) {
-            case NUM: {
-                std::stringstream stream;
-                stream << match.get_source();
-                double v;
-                stream >> v;
-                return v;
-            }
+            case NUM:
+                return match.get_value().get_decimal();
 
             case ADD:
                 assert(match.get_children().size() == 2);
@@ -954,6 +1203,13 @@ static void test_parse_left_recursion() {
         assert(pc.get_matches().size() == 1);
         const double eval_value = eval(pc.get_matches()[0]);
         assert(eval_value == val);
+
+        parse_context_type memoized_pc(source);
+        memoized_pc.set_memoization_enabled(true);
+        const bool memoized_result = grammar.parse(memoized_pc);
+        assert(memoized_result);
+        assert(memoized_pc.get_matches().size() == 1);
+        assert(eval(memoized_pc.get_matches()[0]) == val);
     };
 
     #define TEST_CALC(EXPR) calc(#EXPR, EXPR)
@@ -1234,6 +1490,1376 @@ static void test_parse_left_recursion() {
 }
 
 
+static void test_parse_memoization() {
+    p::rule x = (p::terminal('a') >> 'b')->*1;
+    x.set_memoized(true);
+
+    const auto grammar = (x >> 'c')->*2 | (x >> 'd')->*3;
+
+    {
+        std::string src = "abd";
+        p::parse_context pc(src);
+        const bool ok = grammar.parse(pc);
+        assert(ok);
+        assert(pc.get_iterator() == src.end());
+        assert(pc.get_memoization_miss_count() == 1);
+        assert(pc.get_memoization_hit_count() == 1);
+        assert(pc.get_matches().size() == 1);
+        assert(pc.get_matches()[0].get_id() == 3);
+        assert(pc.get_matches()[0].get_children().size() == 1);
+        assert(pc.get_matches()[0].get_children()[0].get_id() == 1);
+        assert(pc.get_matches()[0].get_children()[0].begin() == src.begin());
+        assert(pc.get_matches()[0].get_children()[0].end() == std::next(src.begin(), 2));
+    }
+
+    {
+        std::string src = "abe";
+        p::parse_context pc(src);
+        const bool ok = grammar.parse(pc);
+        assert(!ok);
+        assert(pc.get_iterator() == src.begin());
+        assert(pc.get_matches().size() == 0);
+    }
+
+    {
+        using ps = parser<stream_source::const_iterator>;
+        ps::rule y = (ps::terminal('a') >> 'b')->*1;
+        y.set_memoized(true);
+        const auto stream_grammar = *((y >> 'c')->*2 | (y >> 'd')->*3) >> ps::end();
+        std::istringstream stream("abdabcabd");
+        const stream_source src(stream, 4);
+        ps::parse_context pc(src);
+        const bool ok = stream_grammar.parse(pc);
+        assert(ok);
+        assert(pc.get_state().get_parse_state().get_position() == 9);
+        assert(pc.get_memoization_miss_count() == 4);
+        assert(pc.get_memoization_hit_count() == 3);
+        assert(pc.get_matches().size() == 3);
+        assert(pc.get_matches()[2].get_id() == 3);
+        assert(pc.get_matches()[2].get_children()[0].begin().get_position() == 6);
+    }
+
+    x.set_memoized(false);
+
+    {
+        std::string src = "abd";
+        p::parse_context pc(src);
+        const bool ok = grammar.parse(pc);
+        assert(ok);
+        assert(pc.get_memoization_miss_count() == 0);
+        assert(pc.get_memoization_hit_count() == 0);
+    }
+}
+
+
+static void test_parse_checkpoint() {
+    const auto grammar = p::terminal('a')->*1 >> p::error(2, p::terminal('b'));
+
+    std::string src = "ab";
+    p::parse_context pc(src);
+    const auto checkpoint = pc.get_checkpoint();
+    const bool ok = grammar.parse(pc);
+    assert(ok);
+    assert(pc.get_iterator() == src.end());
+    assert(pc.get_matches().size() == 1);
+    assert(pc.get_errors().size() == 1);
+
+    pc.restore_checkpoint(checkpoint);
+    assert(pc.get_iterator() == src.begin());
+    assert(pc.get_matches().size() == 0);
+    assert(pc.get_errors().size() == 0);
+    assert(checkpoint.get_match_count() == 0);
+    assert(checkpoint.get_error_count() == 0);
+}
+
+
+template <class Matches>
+static bool is_same_match_tree(const Matches& a, const Matches& b) {
+    if (a.size() != b.size()) {
+        return false;
+    }
+    auto itB = b.begin();
+    for (auto itA = a.begin(); itA != a.end(); ++itA, ++itB) {
+        const auto matchA = *itA;
+        const auto matchB = *itB;
+        if (matchA.get_id() != matchB.get_id() || matchA.begin() != matchB.begin() || matchA.end() != matchB.end()) {
+            return false;
+        }
+        if (!is_same_match_tree(matchA.get_children(), matchB.get_children())) {
+            return false;
+        }
+    }
+    return true;
+}
+
+
+static void test_freeze() {
+    p::rule num, val, mul, add, list, opaque;
+
+    num = +p::range('0', '9');
+    val = num | '(' >> add >> ')';
+    mul = (mul >> '*' >> val) | val;
+    add = (add >> '+' >> mul) | mul;
+    list = 'x' >> (list | p::end());
+    opaque = p::function([](p::parse_context&) { return true; }) >> num;
+
+    assert(add.is_left_recursive());
+    assert(num.is_left_recursive());
+
+    freeze(add);
+    freeze(list);
+    freeze(opaque);
+
+    assert(add.is_left_recursive());
+    assert(mul.is_left_recursive());
+    assert(!val.is_left_recursive());
+    assert(!num.is_left_recursive());
+    assert(!list.is_left_recursive());
+    assert(opaque.is_left_recursive());
+
+    {
+        std::string src = "1+2*(3+4)*5";
+        p::parse_context pc(src);
+        const bool ok = add.parse(pc);
+        assert(ok);
+        assert(pc.get_iterator() == src.end());
+    }
+
+    {
+        std::string src = "xxx";
+        p::parse_context pc(src);
+        const bool ok = list.parse(pc);
+        assert(ok);
+        assert(pc.get_iterator() == src.end());
+    }
+
+    val = num;
+    assert(val.is_left_recursive());
+}
+
+
+static void test_freeze_rule_indexes() {
+    p::rule digit, term, expr;
+
+    digit = p::range('0', '9')->*1;
+    term = ((term >> '*' >> digit)->*2) | digit;
+    expr = ((expr >> '-' >> term)->*3) | term;
+
+    assert(expr.get_or_create_rule_parse_node()->get_index() == p::parse_context::npos_rule_index);
+
+    const std::string src = "1-2*3-4*5*6";
+
+    p::parse_context pc1(src);
+    assert(expr.parse(pc1));
+    assert(pc1.get_iterator() == src.end());
+
+    freeze(expr);
+    assert(expr.get_or_create_rule_parse_node()->get_index() == 0);
+    assert(term.get_or_create_rule_parse_node()->get_index() == 1);
+    assert(digit.get_or_create_rule_parse_node()->get_index() == 2);
+
+    freeze(term);
+    assert(term.get_or_create_rule_parse_node()->get_index() == 0);
+    assert(digit.get_or_create_rule_parse_node()->get_index() == 1);
+    assert(expr.get_or_create_rule_parse_node()->get_index() == 0);
+
+    p::parse_context pc2(src);
+    assert(expr.parse(pc2));
+    assert(pc2.get_iterator() == src.end());
+    assert(is_same_match_tree(pc1.get_matches(), pc2.get_matches()));
+}
+
+
+static void test_span() {
+    {
+        p::rule ws, ident, number, punct, token, tokens;
+
+        ws = *(p::terminal(' ') | '\t' | '\n');
+        ident = (p::range('a', 'z') | p::range('A', 'Z') | '_') >> *(p::range('a', 'z') | p::range('A', 'Z') | p::range('0', '9') | '_');
+        number = +p::range('0', '9');
+        punct = +p::set("+-*/=<>!&|^%~?:;,.(){}[]");
+        token = p::parse_node_ptr(ident)->*1 | p::parse_node_ptr(number)->*2 | p::parse_node_ptr(punct)->*3;
+        tokens = p::parse_node_ptr(ws) >> *(p::parse_node_ptr(token) >> ws) >> p::end();
+
+        const std::string sources[] = {
+            "",
+            "abc 123 +=",
+            "a_very_long_identifier_name_0123456789 = 12345678901234567890123456789 ;; \t\n",
+            "x1\ty2\n   \t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\tz3 <<=>>==!!!!!!!!!!!!!!!!!!!!!",
+            "abc $",
+            "\xe9\xe9\xe9"
+        };
+
+        std::vector<std::tuple<bool, size_t, size_t>> results;
+        for (const std::string& source : sources) {
+            p::parse_context pc(source);
+            const bool ok = tokens.parse(pc);
+            results.emplace_back(ok, pc.get_iterator() - source.begin(), pc.get_matches().size());
+        }
+
+        const optimization_report report = optimize(tokens);
+        assert(report.get_span_count() == 4);
+
+        for (size_t index = 0; index < std::size(sources); ++index) {
+            p::parse_context pc(sources[index]);
+            const bool ok = tokens.parse(pc);
+            assert(results[index] == std::make_tuple(ok, static_cast<size_t>(pc.get_iterator() - sources[index].begin()), pc.get_matches().size()));
+        }
+    }
+
+    {
+        using p = parser<text_iterator<>, int, int, case_insensitive_symbol_comparator>;
+
+        p::parse_node_ptr grammar = +p::range('a', 'f') >> p::terminal(' ') >> -*p::terminal('x') >> p::end();
+        assert(optimize(grammar).get_span_count() == 2);
+
+        std::string src = "aBcDeFaBcDeFaBcDeFaBcDeF XxxXxxXxxXxxXxxXxxX";
+        p::parse_context pc(src);
+        assert(grammar.parse(pc));
+        assert(pc.get_iterator().get_column() == src.size() + 1);
+    }
+}
+
+
+template <class Parser, class Source = std::string>
+static void test_until(const typename Parser::parse_node_ptr& until, const typename Parser::parse_node_ptr& reference) {
+    std::string long_source(1000, 'x');
+    long_source[500] = '*';
+    long_source[998] = '*';
+    long_source[999] = ')';
+
+    const std::string sources[] = {
+        "", "abc*)", "abc", "a*b)*)x", "*)", "**)", "\\*)*)", "\\\\*)", "x\\", "\"a\\\"b\"c", "endEnDx", "aend", long_source
+    };
+
+    for (const std::string& source : sources) {
+        const Source src(source.begin(), source.end());
+        typename Parser::parse_context pc1(src);
+        typename Parser::parse_context pc2(src);
+        const bool ok1 = until.parse(pc1);
+        const bool ok2 = reference.parse(pc2);
+        assert(ok1 == ok2);
+        assert(pc1.get_iterator() == pc2.get_iterator());
+    }
+}
+
+
+static void test_until() {
+    test_until<p>(p::until("*)"), *(p::any() - "*)"));
+    test_until<p>(p::until("*)", until_terminator::include), *(p::any() - "*)") >> "*)");
+    test_until<p>(p::until('"', '\\'), *(p::terminal('\\') >> p::any() | (p::any() - '"')));
+    test_until<p>(p::until("*)", '\\', until_terminator::include), *(p::terminal('\\') >> p::any() | (p::any() - "*)")) >> "*)");
+
+    {
+        using pd = parser<std::deque<char>::const_iterator>;
+        test_until<pd, std::deque<char>>(pd::until("*)", '\\'), *(pd::terminal('\\') >> pd::any() | (pd::any() - "*)")));
+    }
+
+    {
+        using pi = parser<std::string::const_iterator, int, int, case_insensitive_symbol_comparator>;
+        test_until<pi>(pi::until("END", until_terminator::include), *(pi::any() - "END") >> "END");
+        test_until<pi>(pi::until('D'), *(pi::any() - 'D'));
+    }
+
+    {
+        p::parse_node_ptr grammar = "(*" >> *(p::any() - "*)") >> "*)" >> p::end();
+        assert(optimize(grammar).get_until_count() == 1);
+
+        std::string src = "(* a comment * with ) stars *)";
+        p::parse_context pc(src);
+        assert(grammar.parse(pc));
+        assert(pc.get_iterator() == src.end());
+    }
+}
+
+
+template <class Parser, class Source = std::string>
+static void test_lexeme(const typename Parser::parse_node_ptr& lexeme, const typename Parser::parse_node_ptr& reference) {
+    const std::string sources[] = {
+        "", "0", "123", "12a", "1.5", "1.", "1.e5", "1e", "1e+", "1e+5", "1.25E-10x", ".5", "a", "1234567890123456789012345678901234567890.5",
+        "_", "a1_b", "1a", "abc def", "\xe9", "abcdefghijklmnopqrstuvwxyz_ABCDEFGHIJKLMNOPQRSTUVWXYZ_0123456789 x",
+        "\"abc\"", "\"a\\\"b\"x", "\"unterminated", "\"\"", "\"\\\"",
+        "// comment\nx", "//", "/ x", "// no newline"
+    };
+
+    for (const std::string& source : sources) {
+        const Source src(source.begin(), source.end());
+        typename Parser::parse_context pc1(src);
+        typename Parser::parse_context pc2(src);
+        const bool ok1 = (lexeme->*1).parse(pc1);
+        const bool ok2 = (reference->*1).parse(pc2);
+        assert(ok1 == ok2);
+        assert(pc1.get_iterator() == pc2.get_iterator());
+        assert(pc1.get_matches().size() == pc2.get_matches().size());
+        for (size_t index = 0; index < pc1.get_matches().size(); ++index) {
+            assert(pc1.get_matches()[index].end() == pc2.get_matches()[index].end());
+        }
+    }
+}
+
+
+template <class Parser, class Source = std::string>
+static void test_lexemes() {
+    using p = Parser;
+    const auto digit = p::range('0', '9');
+    const auto letter = p::range('a', 'z') | p::range('A', 'Z') | '_';
+    test_lexeme<p, Source>(p::integer(), +digit);
+    test_lexeme<p, Source>(p::decimal(), +digit >> -('.' >> +digit) >> -(p::set("eE") >> -p::set("+-") >> +digit));
+    test_lexeme<p, Source>(p::identifier(), letter >> *(letter | digit));
+    test_lexeme<p, Source>(p::quoted(), '"' >> *('\\' >> p::any() | (p::any() - '"')) >> '"');
+    test_lexeme<p, Source>(p::line_comment("//"), "//" >> *(p::any() - '\n'));
+}
+
+
+static void test_lexemes() {
+    test_lexemes<p>();
+    test_lexemes<parser<std::deque<char>::const_iterator>, std::deque<char>>();
+    test_lexemes<parser<std::u32string::const_iterator>, std::u32string>();
+
+    const auto identifier = p::identifier();
+    assert(dynamic_cast<const identifier_parse_node<p::parse_context>*>(identifier.get())->is_classified());
+}
+
+
+template <class Parser = p, class Source = std::string>
+static numeric_value parse_numeric_value(const typename Parser::parse_node_ptr& number, const std::string& source) {
+    const Source src(source.begin(), source.end());
+    typename Parser::parse_context pc(src);
+    const bool ok = (number->*1).parse(pc);
+    assert(ok);
+    assert(pc.get_iterator() == src.end());
+    assert(pc.get_matches().size() == 1);
+    return pc.get_matches()[0].get_value();
+}
+
+
+template <class Parser = p, class Source = std::string>
+static void test_numeric_values() {
+    const auto value_of = [](const typename Parser::parse_node_ptr& number, const std::string& source) {
+        return parse_numeric_value<Parser, Source>(number, source);
+    };
+
+    const auto integer = Parser::integer(number_sign::minus);
+    assert(value_of(integer, "0").get_integer() == 0);
+    assert(value_of(integer, "1234567").get_integer() == 1234567);
+    assert(value_of(integer, "-42").get_integer() == -42);
+    assert(value_of(integer, "9223372036854775807").get_integer() == std::numeric_limits<std::int64_t>::max());
+    assert(value_of(integer, "-9223372036854775808").get_integer() == std::numeric_limits<std::int64_t>::min());
+    assert(value_of(integer, "9223372036854775808").empty());
+    assert(value_of(integer, "123456789012345678901234567890").empty());
+    assert(value_of(integer, "7").get_kind() == numeric_value_kind::integer);
+
+    const auto decimal = Parser::decimal(number_sign::plus_minus);
+    const char* decimals[] = {
+        "0", "1", "-1", "+2.5", "0.1", "3.14159265358979323846", "1e10", "1E-5", "-2.5e+3", "123456789012345678901234567890",
+        "0.000000000000000000000000000001", "9007199254740993", "1.7976931348623157e308", "4.9e-324", "2.2250738585072014e-308",
+        "1e400", "-1e400", "1e-400", "0e999", "00000000000000000000000000001.5"
+    };
+    for (const char* source : decimals) {
+        const numeric_value value = value_of(decimal, source);
+        assert(value.get_kind() == numeric_value_kind::decimal);
+        assert(value.get_decimal() == std::strtod(source, nullptr));
+    }
+
+    assert(value_of(decimal, "-2.75").get_integer() == -2);
+    assert(value_of(decimal, "1e18").get_integer() == 1000000000000000000);
+    assert(value_of(decimal, "1e19").get_integer() == std::numeric_limits<std::int64_t>::max());
+    assert(value_of(decimal, "-1e19").get_integer() == std::numeric_limits<std::int64_t>::min());
+    assert(value_of(decimal, "1e400").get_integer() == std::numeric_limits<std::int64_t>::max());
+    assert(value_of(decimal, "-1e400").get_integer() == std::numeric_limits<std::int64_t>::min());
+    assert(numeric_value(std::numeric_limits<double>::quiet_NaN()).get_integer() == 0);
+}
+
+
+static void test_numeric_values() {
+    test_numeric_values<>();
+    test_numeric_values<parser<std::deque<char>::const_iterator>, std::deque<char>>();
+
+    {
+        std::string src = "12 x";
+        p::parse_context pc(src);
+        const bool ok = ((p::integer() >> ' ')->*1 >> 'x').parse(pc);
+        assert(ok);
+        assert(pc.get_matches()[0].get_value().empty());
+    }
+
+    {
+        std::string src = "12y";
+        p::parse_context pc(src);
+        const bool ok = ((p::integer() >> 'x') | (p::any() >> p::any())->*1).parse(pc);
+        assert(ok);
+        assert(pc.get_matches().size() == 1);
+        assert(pc.get_matches()[0].get_value().empty());
+    }
+
+    {
+        p::rule num = p::integer();
+        const auto grammar = (p::parse_node_ptr(num)->*1 >> 'x') | (p::parse_node_ptr(num) >> '+' >> p::parse_node_ptr(num)->*3 >> 'y') | (p::parse_node_ptr(num)->*2);
+
+        for (bool memoized : { false, true }) {
+            std::string src = "12+34";
+            p::parse_context pc(src);
+            pc.set_memoization_enabled(memoized);
+            assert(grammar.parse(pc));
+            assert(pc.get_matches().size() == 1);
+            assert(pc.get_matches()[0].get_id() == 2);
+            assert(pc.get_matches()[0].get_value().get_integer() == 12);
+            assert(!memoized || pc.get_memoization_hit_count() == 2);
+        }
+    }
+}
+
+
+static void test_mapped_source() {
+    const std::string filename = (std::filesystem::temp_directory_path() / "parserlib_test_mapped_source.txt").string();
+    {
+        std::ofstream file(filename, std::ios::binary);
+        file << "alpha 12 beta 345\n";
+    }
+
+    {
+        using pm = parser<mapped_source::const_iterator>;
+        const mapped_source source(filename);
+        assert(source.size() == 18);
+
+        const auto grammar = *((pm::identifier()->*1 | pm::integer()->*2) >> *pm::set(" \n")) >> pm::end();
+        pm::parse_context pc(source);
+        assert(grammar.parse(pc));
+        assert(pc.get_matches().size() == 4);
+        assert(pc.get_matches()[0].begin() == source.data());
+        assert(pc.get_matches()[3].get_source() == "345");
+        assert(pc.get_matches()[3].get_value().get_integer() == 345);
+    }
+
+    {
+        std::ofstream file(filename, std::ios::binary | std::ios::trunc);
+    }
+
+    {
+        const mapped_source source(filename);
+        assert(source.empty());
+        assert(source.begin() == source.end());
+    }
+
+    std::remove(filename.c_str());
+
+    bool thrown = false;
+    try {
+        mapped_source source(filename);
+    }
+    catch (const std::system_error&) {
+        thrown = true;
+    }
+    assert(thrown);
+}
+
+
+static void test_stream_source() {
+    using ps = parser<stream_source::const_iterator>;
+
+    std::string text;
+    for (size_t index = 0; index < 10000; ++index) {
+        text += static_cast<char>('a' + index % 26);
+        text += index % 7 == 0 ? " " : "";
+    }
+
+    {
+        std::istringstream stream(text);
+        const stream_source source(stream, 64);
+        const auto grammar = *(ps::range('a', 'z') | ' ');
+        ps::parse_context pc(source);
+        assert(grammar.parse(pc));
+        assert(pc.get_iterator() == source.end());
+        assert(source.get_released_chunk_count() > 100);
+        assert(source.get_max_buffered_chunk_count() <= 2);
+    }
+
+    {
+        std::istringstream stream(text);
+        const stream_source source(stream, 64);
+        const auto grammar = (*ps::any() >> 'x') | (ps::terminal("a bcdefgh") >> *ps::any() >> ps::end());
+        ps::parse_context pc(source);
+        assert(grammar.parse(pc));
+        assert(source.get_max_buffered_chunk_count() > 100);
+    }
+
+    {
+        std::istringstream stream(text);
+        const stream_source source(stream, 64);
+        const auto grammar = *((+ps::range('a', 'z'))->*1 | ' ') >> ps::end();
+        ps::parse_context pc(source);
+        assert(grammar.parse(pc));
+        assert(pc.get_matches().size() == 1430);
+        assert(pc.get_matches()[0].get_source() == "a");
+        assert(pc.get_matches()[1].get_source() == "bcdefgh");
+        assert(pc.get_matches().back().end() == source.end());
+    }
+
+    {
+        std::istringstream stream("");
+        const stream_source source(stream, 64);
+        assert(source.begin() == source.end());
+    }
+}
+
+
+static void test_cut() {
+    {
+        const auto grammar = (p::terminal('a') >> p::cut() >> 'b') | "ac";
+        const std::string src = "ac";
+        p::parse_context pc(src);
+        assert(!grammar.parse(pc));
+        assert(pc.get_cut_count() == 1);
+
+        const auto compiled_grammar = compile(grammar);
+        p::parse_context pc1(src);
+        assert(!compiled_grammar.parse(pc1));
+    }
+
+    {
+        const auto grammar = (p::terminal('a') >> 'b') | "ac";
+        const std::string src = "ac";
+        p::parse_context pc(src);
+        assert(grammar.parse(pc));
+    }
+
+    {
+        const auto grammar = (&((p::terminal('a') >> p::cut() >> 'b') | (p::terminal('a') >> 'c')) >> p::terminal("ac")->*1) | p::terminal("ac")->*2;
+        const std::string src = "ac";
+        p::parse_context pc(src);
+        assert(grammar.parse(pc));
+        assert(pc.get_matches().size() == 1);
+        assert(pc.get_matches()[0].get_id() == 2);
+        assert(pc.get_cut_count() == 0);
+
+        const auto compiled_grammar = compile(grammar);
+        p::parse_context pc1(src);
+        assert(compiled_grammar.parse(pc1));
+        assert(pc1.get_matches().size() == 1);
+        assert(pc1.get_matches()[0].get_id() == 2);
+    }
+
+    {
+        const auto grammar = !((p::terminal('a') >> p::cut() >> 'b') | 'a') >> "ac";
+        const std::string src = "ac";
+        p::parse_context pc(src);
+        assert(grammar.parse(pc));
+        assert(pc.get_iterator() == src.end());
+
+        const auto compiled_grammar = compile(grammar);
+        p::parse_context pc1(src);
+        assert(compiled_grammar.parse(pc1));
+        assert(pc1.get_iterator() == src.end());
+    }
+
+    {
+        const auto grammar = *(p::cut() >> -p::terminal('x')) >> "ab";
+        const std::string src = "ab";
+        p::parse_context pc(src);
+        assert(grammar.parse(pc));
+        assert(pc.get_cut_count() == 1);
+
+        const auto compiled_grammar = compile(grammar);
+        p::parse_context pc1(src);
+        assert(compiled_grammar.parse(pc1));
+        assert(pc1.get_cut_count() == 1);
+    }
+
+    {
+        p::rule expr;
+        expr = ((expr >> '+' >> p::cut() >> p::range('0', '9'))->*1) | p::range('0', '9');
+        const auto grammar = (expr >> p::end()) | p::terminal("1+2+x")->*2;
+
+        const std::string src1 = "1+2";
+        p::parse_context pc1(src1);
+        assert(grammar.parse(pc1));
+        assert(pc1.get_matches().size() == 1);
+        assert(pc1.get_matches()[0].get_id() == 1);
+        assert(pc1.get_cut_count() == 0);
+
+        const std::string src2 = "1+2+x";
+        p::parse_context pc2(src2);
+        assert(grammar.parse(pc2));
+        assert(pc2.get_matches().size() == 1);
+        assert(pc2.get_matches()[0].get_id() == 2);
+    }
+
+    {
+        const auto word = (+p::range('a', 'z'))->*1 >> *p::terminal(' ') >> p::cut();
+        const auto grammar = *word >> p::end();
+        const std::string src = "one two three";
+        std::vector<std::string> committed;
+        p::parse_context pc(src);
+        pc.set_commit_handler([&](const auto& matches) {
+            for (const auto& match : matches) {
+                committed.push_back(match.get_source());
+            }
+        });
+        assert(grammar.parse(pc));
+        assert((committed == std::vector<std::string>{ "one", "two", "three" }));
+        assert(pc.get_matches().empty());
+        assert(pc.get_committed_match_count() == 3);
+    }
+
+    {
+        const auto grammar = (p::terminal('a')->*1 >> p::cut() >> p::terminal('b')->*2)->*3 >> p::end();
+        const std::string src = "ab";
+        size_t committed = 0;
+        p::parse_context pc(src);
+        pc.set_commit_handler([&](const auto& matches) {
+            committed += matches.size();
+        });
+        assert(grammar.parse(pc));
+        assert(committed == 1);
+        assert(pc.get_matches().size() == 1);
+        assert(pc.get_matches()[0].get_id() == 3);
+        assert(pc.get_matches()[0].get_source() == "ab");
+        assert(pc.get_matches()[0].get_children().size() == 1);
+        assert(pc.get_matches()[0].get_children()[0].get_id() == 2);
+    }
+
+    {
+        using ps = parser<stream_source::const_iterator>;
+
+        std::string text;
+        for (size_t index = 0; index < 10000; ++index) {
+            text += static_cast<char>('a' + index % 26);
+            text += index % 7 == 0 ? " " : "";
+        }
+
+        const auto word = (+ps::range('a', 'z'))->*1 >> *ps::terminal(' ') >> ps::cut();
+
+        std::istringstream stream(text);
+        const stream_source source(stream, 64);
+        size_t committed = 0;
+        ps::parse_context pc(source);
+        pc.set_commit_handler([&](const auto& matches) {
+            committed += matches.size();
+        });
+        assert((*word >> ps::end()).parse(pc));
+        assert(committed == 1430);
+        assert(source.get_max_buffered_chunk_count() <= 2);
+
+        std::istringstream stream1(text + "1");
+        const stream_source source1(stream1, 64);
+        ps::parse_context pc1(source1);
+        pc1.set_commit_handler([](const auto&) {});
+        assert(!(*word >> ps::end()).parse(pc1));
+        assert(source1.get_max_buffered_chunk_count() <= 2);
+
+        std::istringstream stream2(std::string(6400, ' ') + "!" + text);
+        const stream_source source2(stream2, 64);
+        ps::parse_context pc2(source2);
+        assert((ps::cut() >> *ps::terminal(' ') >> ps::error(1, ps::terminal('!')) >> *word >> ps::end()).parse(pc2));
+        assert(source2.get_released_chunk_count() == 100);
+        assert(source2.get_max_buffered_chunk_count() <= 180);
+        assert(pc2.get_errors().size() == 1);
+        assert(pc2.get_errors()[0].get_source() == "!");
+        assert(pc2.get_matches().size() == 1430);
+        assert(pc2.get_matches()[0].get_source() == "a");
+    }
+
+    {
+        using ps = parser<stream_source::const_iterator>;
+
+        std::string text;
+        for (size_t index = 0; index < 50; ++index) {
+            text += "abcdefgh";
+        }
+
+        const auto grammar = *((ps::terminal("abcdef") >> ps::cut() >> "gh")->*1) >> ps::end();
+
+        std::istringstream stream(text);
+        const stream_source source(stream, 4);
+        ps::parse_context pc(source);
+        assert(grammar.parse(pc));
+        assert(pc.get_matches().size() == 50);
+        assert(pc.get_matches()[0].get_source() == "abcdefgh");
+        assert(pc.get_matches()[49].get_source() == "abcdefgh");
+
+        std::istringstream stream1(text);
+        const stream_source source1(stream1, 4);
+        size_t committed = 0;
+        ps::parse_context pc1(source1);
+        pc1.set_commit_handler([&](const auto& matches) {
+            for (const auto& match : matches) {
+                assert(match.get_source() == "abcdefgh");
+                ++committed;
+            }
+        });
+        assert(grammar.parse(pc1));
+        assert(committed == 49);
+        assert(pc1.get_matches().size() == 1);
+        assert(pc1.get_matches()[0].get_source() == "abcdefgh");
+        assert(source1.get_max_buffered_chunk_count() <= 5);
+
+        const auto compiled_grammar = compile(grammar);
+        std::istringstream stream2(text);
+        const stream_source source2(stream2, 4);
+        committed = 0;
+        ps::parse_context pc2(source2);
+        pc2.set_commit_handler([&](const auto& matches) {
+            for (const auto& match : matches) {
+                assert(match.get_source() == "abcdefgh");
+                ++committed;
+            }
+        });
+        assert(compiled_grammar.parse(pc2));
+        assert(committed == 49);
+        assert(pc2.get_matches()[0].get_source() == "abcdefgh");
+        assert(source2.get_max_buffered_chunk_count() <= 5);
+
+        std::istringstream stream3(std::string(400, ' ') + "abcdefgh");
+        const stream_source source3(stream3, 4);
+        ps::parse_context pc3(source3);
+        assert((ps::error(1, *ps::terminal(' ') >> ps::cut() >> "abcdefgh") >> ps::end()).parse(pc3));
+        assert(pc3.get_errors().size() == 1);
+        assert(pc3.get_errors()[0].get_source().size() == 408);
+    }
+}
+
+
+static void test_segmented_source() {
+    using ps = parser<segmented_source::const_iterator>;
+
+    const std::string buffers[] = { "select ", "", "na", "me, id", "_1 from t", "able;" };
+    const segmented_source source(buffers);
+    assert(source.size() == 29);
+    assert(source.get_segments().size() == 5);
+    assert(std::string(source.begin(), source.end()) == "select name, id_1 from table;");
+
+    {
+        auto it = source.begin() + 9;
+        assert(*it == 'm');
+        assert(it.get_segment_size() == 6);
+        --it;
+        assert(*it == 'a');
+        assert(it.get_segment_size() == 1);
+        assert(std::distance(source.begin(), source.end()) == 29);
+        assert(source.end() - 5 == std::find(source.begin(), source.end(), 'a') + 16);
+    }
+
+    const auto ws = *ps::terminal(' ');
+    const auto name = ps::identifier()->*1;
+    auto grammar = ps::terminal("select") >> ws >> name >> *(ps::terminal(',') >> ws >> name) >> ws >> "from" >> ws >> name >> ';' >> ps::end();
+
+    const auto check = [&](const auto& grammar) {
+        ps::parse_context pc(source);
+        assert(grammar.parse(pc));
+        assert(pc.get_matches().size() == 3);
+        assert(pc.get_matches()[0].get_source() == "name");
+        assert(pc.get_matches()[1].get_source() == "id_1");
+        assert(pc.get_matches()[2].get_source() == "table");
+        assert(get_iterator_address(pc.get_matches()[1].begin()) == buffers[3].data() + 4);
+        assert(get_iterator_address(pc.get_matches()[2].begin()) == buffers[4].data() + 8);
+    };
+
+    check(grammar);
+    assert(optimize(grammar).get_span_count() > 0);
+    check(grammar);
+
+    {
+        const std::vector<std::string_view> views = { "123", "45.", "5e", "1x" };
+        const segmented_source numbers(views);
+        ps::parse_context pc(numbers);
+        assert((ps::decimal()->*1 >> 'x' >> ps::end()).parse(pc));
+        assert(pc.get_matches()[0].get_value().get_decimal() == 12345.5e1);
+    }
+
+    {
+        const segmented_source empty;
+        ps::parse_context pc(empty);
+        assert(empty.begin() == empty.end());
+        assert(ps::end().parse(pc));
+    }
+}
+
+
+static void test_padded_source() {
+    using pp = parser<padded_source::const_iterator>;
+
+    const padded_source source("abc");
+    assert(source.size() == 3);
+    assert(source.get_view() == "abc");
+    assert(std::all_of(source.data() + 3, source.data() + 3 + padded_source::padding, [](char c) { return c == 0; }));
+    assert(padded_source(source).get_view() == "abc");
+    const padded_source empty;
+    assert(empty.begin() == empty.end());
+    assert(*empty.end() == 0);
+
+    std::string data;
+    for (size_t index = 0; index < 300; ++index) {
+        data += static_cast<char>((index * 7919) % 256);
+    }
+    const padded_source padded_data(data);
+    const char* class_symbols[] = { "abcdefghijklmnopqrstuvwxyz", "0123456789", "aceg", "\n" };
+    for (const char* symbols : class_symbols) {
+        const symbol_class symbol_class = make_symbol_class(symbols);
+        std::bitset<256> all_but_zero;
+        all_but_zero.set();
+        all_but_zero[0] = false;
+        for (const auto& scanned : { symbol_class, parserlib::symbol_class(~symbol_class.get_symbols()), parserlib::symbol_class(all_but_zero) }) {
+            for (size_t begin = 0; begin < data.size(); begin += 13) {
+                for (size_t size = 0; begin + size <= data.size(); size += 17) {
+                    const auto* bytes = reinterpret_cast<const unsigned char*>(padded_data.data() + begin);
+                    assert(scanned.scan_padded(bytes, size) == scanned.scan(bytes, size));
+                }
+            }
+        }
+    }
+
+    test_lexemes<pp, padded_source>();
+
+    {
+        pp::parse_node_ptr grammar = *((pp::identifier()->*1 | pp::decimal()->*2 | pp::quoted()->*3) >> *pp::terminal(' ')) >> pp::end();
+        optimize(grammar);
+        const padded_source src("abc 12.5e3 \"x y\" def 42");
+        pp::parse_context pc(src);
+        assert(grammar.parse(pc));
+        assert(pc.get_matches().size() == 5);
+        assert(pc.get_matches()[1].get_value().get_decimal() == 12.5e3);
+        assert(pc.get_matches()[2].get_source() == "\"x y\"");
+        assert(pc.get_matches()[4].get_value().get_integer() == 42);
+    }
+
+    {
+        pp::rule add;
+        add = (add >> '+' >> pp::integer()->*1) | pp::integer()->*1;
+        const padded_source src("1+22+333");
+        pp::parse_context pc(src);
+        assert(add.parse(pc));
+        assert(pc.get_iterator() == src.end());
+        assert(pc.get_matches().size() == 3);
+        assert(pc.get_matches()[2].get_value().get_integer() == 333);
+    }
+}
+
+
+static void test_skip_prefilter() {
+    std::string garbage;
+    for (int index = 0; index < 1000; ++index) {
+        const char ch = static_cast<char>((index * 37) % 256);
+        if (ch != ';' && ch != '\n' && ch != '/') {
+            garbage += ch;
+        }
+    }
+    garbage += "e en enx";
+
+    {
+        const auto skip = p::skip_before(p::terminal("end"));
+        const auto grammar = p::error(1, skip) >> "end" >> p::end();
+        const std::string src = garbage + "end";
+
+        p::parse_context pc1(src);
+        assert(grammar.parse(pc1));
+
+        freeze(grammar);
+        assert(dynamic_cast<const skip_before_parse_node<p::parse_context>*>(skip.get())->is_prefiltered());
+        p::parse_context pc2(src);
+        assert(grammar.parse(pc2));
+        assert(pc2.get_errors().size() == 1);
+        assert(pc2.get_errors()[0].end() == src.end() - 3);
+
+        p::parse_context pc3(garbage);
+        assert(!grammar.parse(pc3));
+    }
+
+    {
+        const auto skip = p::skip_after(p::set(";\n") | p::terminal("*/"));
+        const auto grammar = *(p::error(1, skip));
+        freeze(grammar);
+        assert(dynamic_cast<const skip_after_parse_node<p::parse_context>*>(skip.get())->is_prefiltered());
+        const std::string src = garbage + ";" + garbage + "*/" + garbage + "\n";
+        p::parse_context pc(src);
+        assert(grammar.parse(pc));
+        assert(pc.get_errors().size() == 3);
+        assert(pc.get_errors()[0].end() == src.begin() + garbage.size() + 1);
+        assert(pc.get_errors()[1].end() == src.begin() + 2 * garbage.size() + 3);
+    }
+
+    {
+        using p = parser<text_iterator<>, int, int, case_insensitive_symbol_comparator>;
+        const auto grammar = p::skip_before(p::terminal("END")) >> "end";
+        freeze(grammar);
+        const std::string src = garbage + "End";
+        p::parse_context pc(src);
+        assert(grammar.parse(pc));
+        assert(pc.get_iterator().get_column() == src.size() + 1);
+    }
+
+    {
+        const auto skip = p::skip_before(-p::terminal('x'));
+        freeze(skip);
+        assert(!dynamic_cast<const skip_before_parse_node<p::parse_context>*>(skip.get())->is_prefiltered());
+    }
+}
+
+
+class plain_symbol_comparator {
+public:
+    template <class L, class R>
+    static int compare(const L& l, const R& r) {
+        return static_cast<int>(l) - static_cast<int>(r);
+    }
+};
+
+
+template <class P>
+static void test_one_of(const std::string& src, size_t first_length, size_t longest_length) {
+    const auto first = P::one_of({ "in", "int", "", "integer", "if", "int" });
+    const auto longest = P::one_of({ "in", "int", "integer", "if", "int" }, one_of_match::longest);
+    {
+        typename P::parse_context pc(src);
+        assert(first.parse(pc));
+        assert(static_cast<size_t>(pc.get_iterator() - src.begin()) == first_length);
+    }
+    {
+        typename P::parse_context pc(src);
+        const bool ok = longest.parse(pc);
+        assert(ok == (longest_length > 0));
+        assert(static_cast<size_t>(pc.get_iterator() - src.begin()) == longest_length);
+    }
+}
+
+
+template <class ParseContext, class SkipParseNode>
+static void test_skip_patterns(const parse_node_ptr<ParseContext>& grammar, const std::shared_ptr<SkipParseNode>& skip, bool multi_pattern) {
+    const char* sources[] = {
+        "zabcd;",
+        "xxendixx elsxx elsif",
+        "e en els else",
+        "ELSIF",
+        "}",
+        "",
+        "no sync point at all"
+    };
+
+    std::vector<std::tuple<bool, size_t, size_t>> results;
+    for (const char* src : sources) {
+        std::string source = src;
+        ParseContext pc(source);
+        const bool ok = grammar.parse(pc);
+        results.emplace_back(ok, pc.get_iterator() - source.begin(), pc.get_errors().size());
+    }
+
+    freeze(grammar);
+    assert(skip->is_prefiltered());
+    assert(skip->get_prefilter().is_multi_pattern() == multi_pattern);
+
+    for (size_t index = 0; index < std::size(sources); ++index) {
+        std::string source = sources[index];
+        ParseContext pc(source);
+        const bool ok = grammar.parse(pc);
+        assert(results[index] == std::make_tuple(ok, static_cast<size_t>(pc.get_iterator() - source.begin()), pc.get_errors().size()));
+    }
+}
+
+
+static void test_skip_patterns() {
+    {
+        const auto skip = std::make_shared<skip_before_parse_node<p::parse_context>>(p::terminal("abcd") | p::terminal('c') | "endif" | "dif" | ';' | '}' | "else" | "elsif");
+        test_skip_patterns(p::error(1, p::parse_node_ptr(skip)) >> *p::any(), skip, true);
+    }
+
+    {
+        const auto skip = std::make_shared<skip_after_parse_node<p::parse_context>>(p::one_of({ "end", "elsif", "}" }));
+        test_skip_patterns(*p::error(1, p::parse_node_ptr(skip)) >> *p::any(), skip, true);
+    }
+
+    {
+        using p = parser<std::string::const_iterator, int, int, case_insensitive_symbol_comparator>;
+        const auto skip = std::make_shared<skip_before_parse_node<p::parse_context>>(p::terminal("Elsif") | "eLSe");
+        test_skip_patterns(p::error(1, p::parse_node_ptr(skip)) >> *p::any(), skip, true);
+    }
+
+    {
+        const auto skip = std::make_shared<skip_before_parse_node<p::parse_context>>(p::terminal(';') | '}');
+        test_skip_patterns(p::error(1, p::parse_node_ptr(skip)) >> *p::any(), skip, false);
+    }
+}
+
+
+static void test_one_of() {
+    test_one_of<p>("integers", 2, 7);
+    test_one_of<p>("int", 2, 3);
+    test_one_of<p>("i", 0, 0);
+    test_one_of<p>("INTEGER", 0, 0);
+    test_one_of<parser<std::string::const_iterator, int, int, case_insensitive_symbol_comparator>>("INTEGER", 2, 7);
+    test_one_of<parser<std::string::const_iterator, int, int, plain_symbol_comparator>>("integers", 2, 7);
+    test_one_of<parser<std::string::const_iterator, int, int, plain_symbol_comparator>>("iF", 0, 0);
+
+    {
+        std::vector<std::string> keywords{ "select", "from", "where", "set", "sel", "order", "by", "or" };
+        const auto grammar = *(p::one_of(keywords)->*1 | p::terminal(' ')) >> p::end();
+        std::string src = "select from set sel where order by or";
+        p::parse_context pc(src);
+        assert(grammar.parse(pc));
+        assert(pc.get_matches().size() == 8);
+    }
+
+    {
+        p::rule keyword, grammar;
+        keyword = p::terminal("sel") | "select" | 'f' >> p::terminal("rom") | "where" | "set" | p::terminal('x') | "order";
+        grammar = *(p::parse_node_ptr(keyword)->*1 | p::range('a', 'z') | ' ') >> p::end();
+
+        const char* sources[] = { "select from where", "set order xx", "selec fro whe", "", "frm sel" };
+        std::vector<std::tuple<bool, size_t, size_t>> results;
+        for (const char* src : sources) {
+            std::string source = src;
+            p::parse_context pc(source);
+            const bool ok = grammar.parse(pc);
+            results.emplace_back(ok, pc.get_iterator() - source.begin(), pc.get_matches().size());
+        }
+
+        const optimization_report report = optimize(grammar);
+        assert(report.get_one_of_count() == 7);
+
+        for (size_t index = 0; index < std::size(sources); ++index) {
+            std::string source = sources[index];
+            p::parse_context pc(source);
+            const bool ok = grammar.parse(pc);
+            assert(results[index] == std::make_tuple(ok, static_cast<size_t>(pc.get_iterator() - source.begin()), pc.get_matches().size()));
+        }
+    }
+}
+
+
+static void test_choice_dispatch() {
+    {
+        p::rule ws, ident, num, value, add, mul, stmt, program;
+
+        ws = *p::set(" \n");
+        ident = (p::range('a', 'z') >> *(p::range('a', 'z') | p::range('0', '9')))->*1;
+        num = (+p::range('0', '9'))->*2;
+        value = p::parse_node_ptr(num) | ident | ('(' >> add >> ')');
+        mul = (mul >> '*' >> value)->*3 | value;
+        add = (add >> '+' >> mul)->*4 | mul;
+
+        const p::parse_node_ptr statement
+            = (p::terminal("let") >> ws >> ident >> ws >> '=' >> ws >> add >> ';')->*5
+            | (p::terminal("print") >> ws >> add >> ';')->*6
+            | (p::terminal("if") >> ws >> add >> ws >> '{' >> ws >> *(p::parse_node_ptr(stmt) >> ws) >> '}')->*7
+            | (p::parse_node_ptr(ident) >> ws >> '=' >> ws >> add >> ';')->*8
+            | (p::terminal('#') >> *(p::any() - '\n'))
+            | (-p::terminal('!') >> ';')->*9;
+
+        stmt = statement;
+        program = *(p::parse_node_ptr(ws) >> stmt) >> ws >> p::end();
+
+        const char* sources[] = {
+            "let a = 1; print a*(2+b); if x { let1 = 2; ; # comment\n }",
+            "print 1 + ; let = 3;",
+            "!; ;",
+            ""
+        };
+
+        std::vector<std::tuple<bool, size_t, size_t>> results;
+        for (const char* src : sources) {
+            std::string source = src;
+            p::parse_context pc(source);
+            const bool ok = program.parse(pc);
+            results.emplace_back(ok, pc.get_iterator() - source.begin(), pc.get_matches().size());
+        }
+
+        freeze(program);
+        assert(dynamic_cast<const choice_parse_node<p::parse_context>*>(statement.get())->is_dispatched());
+
+        for (size_t index = 0; index < std::size(sources); ++index) {
+            std::string source = sources[index];
+            p::parse_context pc(source);
+            const bool ok = program.parse(pc);
+            assert(results[index] == std::make_tuple(ok, static_cast<size_t>(pc.get_iterator() - source.begin()), pc.get_matches().size()));
+        }
+    }
+
+    {
+        using p = parser<std::string::const_iterator, int, int, case_insensitive_symbol_comparator>;
+
+        const auto choice = p::terminal("if") | p::terminal("else") | p::range('a', 'c') | p::terminal(' ');
+        const auto grammar = *choice >> p::end();
+        freeze(grammar);
+        assert(dynamic_cast<const choice_parse_node<p::parse_context>*>(choice.get())->is_dispatched());
+        std::string src = "IF a ELSE B if C";
+        p::parse_context pc(src);
+        const bool ok = grammar.parse(pc);
+        assert(ok);
+        assert(pc.get_iterator() == src.end());
+    }
+
+    {
+        enum { A, B, C, D };
+
+        const auto lexer = *((+p::terminal('a'))->*A | (+p::terminal('b'))->*B | (+p::terminal('c'))->*C | (+p::terminal('d'))->*D);
+        std::string src = "aabcddb";
+        p::parse_context pc(src);
+        assert(lexer.parse(pc));
+
+        using pp = p::derived_parser_type<int, int>;
+        const auto choice = pp::terminal(A) >> pp::terminal(B) | pp::terminal(C) | pp::terminal(D) >> pp::terminal(B) | pp::terminal(B);
+        const auto grammar = *choice >> pp::end();
+        freeze(grammar);
+        assert(dynamic_cast<const choice_parse_node<pp::parse_context>*>(choice.get())->is_dispatched());
+
+        auto token_pc = pc.derive_parse_context<int, int>();
+        assert(grammar.parse(token_pc));
+    }
+
+    {
+        const auto grammar = *(((p::terminal('a') >> ';')->*1) | p::error(1, p::skip_before(';')) >> ';');
+
+        for (bool frozen : { false, true }) {
+            if (frozen) {
+                freeze(grammar);
+            }
+            std::string src = "bx;a;";
+            p::parse_context pc(src);
+            assert(grammar.parse(pc));
+            assert(pc.get_iterator() == src.end());
+            assert(pc.get_matches().size() == 1);
+            assert(pc.get_errors().size() == 1);
+            assert(pc.get_errors()[0].begin() == src.begin());
+            assert(pc.get_errors()[0].end() == std::next(src.begin(), 2));
+        }
+    }
+}
+
+
+static void test_optimize() {
+    {
+        p::rule ws, keyword, ident, stmt, program;
+
+        ws = *p::terminal(' ');
+        keyword = p::terminal('i') >> 'f' | p::terminal('d') >> 'o' >> true;
+        ident = (p::terminal('_') | p::range('a', 'z') | 'A' | 'B')->*1 >> -*(p::range('a', 'z') | '_');
+        stmt = (p::parse_node_ptr(keyword) >> ws >> ident >> ws >> ';')->*2 | false | (p::parse_node_ptr(ident) >> p::terminal('=') >> '=' >> ws >> ';')->*3;
+        program = *(p::parse_node_ptr(ws) >> stmt) >> ws >> p::end();
+
+        const char* sources[] = { "if abc; do _x; A==;", "if abc; do 1;", "ifx;", "" };
+
+        std::vector<std::tuple<bool, size_t, size_t>> results;
+        for (const char* src : sources) {
+            std::string source = src;
+            p::parse_context pc(source);
+            const bool ok = program.parse(pc);
+            results.emplace_back(ok, pc.get_iterator() - source.begin(), pc.get_matches().size());
+        }
+
+        const optimization_report report = optimize(program);
+        assert(report.get_merged_string_count() == 3);
+        assert(report.get_merged_set_count() == 6);
+        assert(report.get_folded_bool_count() == 2);
+        assert(report.get_removed_loop_count() == 1);
+        assert(report.get_removed_ref_count() > 0);
+        assert(report.get_change_count() > 12);
+        assert(optimize(program).get_change_count() == 0);
+
+        for (size_t index = 0; index < std::size(sources); ++index) {
+            std::string source = sources[index];
+            p::parse_context pc(source);
+            const bool ok = program.parse(pc);
+            assert(results[index] == std::make_tuple(ok, static_cast<size_t>(pc.get_iterator() - source.begin()), pc.get_matches().size()));
+        }
+    }
+
+    {
+        p::parse_node_ptr grammar = p::terminal('a') >> false >> 'b' | (p::parse_node_ptr(false) >> 'c') | 'x' >> p::terminal('y');
+        const optimization_report report = optimize(grammar);
+        assert(report.get_change_count() > 0);
+
+        std::string src = "xy";
+        p::parse_context pc(src);
+        assert(grammar.parse(pc));
+        assert(pc.get_iterator() == src.end());
+    }
+}
+
+
+template <class Grammar>
+static void test_compiled_grammar(const Grammar& grammar, const std::string& src, bool memoization = false) {
+    const auto compiled_grammar = compile(grammar);
+
+    p::parse_context pc1(src);
+    pc1.set_memoization_enabled(memoization);
+    const bool ok1 = grammar.parse(pc1);
+
+    p::parse_context pc2(src);
+    pc2.set_memoization_enabled(memoization);
+    const bool ok2 = compiled_grammar.parse(pc2);
+
+    assert(ok1 == ok2);
+    assert(pc1.get_iterator() == pc2.get_iterator());
+    assert(is_same_match_tree(pc1.get_matches(), pc2.get_matches()));
+    assert(pc1.get_errors().size() == pc2.get_errors().size());
+    for (size_t index = 0; index < pc1.get_errors().size(); ++index) {
+        assert(pc1.get_errors()[index].get_id() == pc2.get_errors()[index].get_id());
+        assert(pc1.get_errors()[index].begin() == pc2.get_errors()[index].begin());
+        assert(pc1.get_errors()[index].end() == pc2.get_errors()[index].end());
+    }
+}
+
+
+static void test_compile() {
+    p::rule ws, ident, num, value, stmt, program, add, mul, list;
+
+    ws = *p::set(" \n");
+    ident = (p::range('a', 'z') >> *(p::range('a', 'z') | p::range('0', '9')))->*1;
+    num = (+p::set("0123456789"))->*2;
+    value = p::parse_node_ptr(num) | ident | ('(' >> add >> ')');
+    mul = (mul >> '*' >> value)->*3 | value;
+    add = (add >> '+' >> mul)->*4 | mul;
+    list = value >> -(ws >> ',' >> ws >> list);
+
+    stmt
+        = (p::terminal("let") >> ws >> ident >> ws >> '=' >> ws >> add >> ws >> ';')->*5
+        | (p::terminal("list") >> ws >> &p::terminal('[') >> '[' >> list >> ']' >> ws >> ';')->*6
+        | (2 * p::terminal('#') >> !p::terminal('#') >> p::function([](p::parse_context&) { return true; }) >> *p::any())->*7
+        | p::error(8, *(!p::terminal(';') >> p::any()) >> ';')
+        ;
+
+    program = *(p::parse_node_ptr(ws) >> stmt) >> ws >> p::end();
+
+    const char* sources[] = {
+        "let a = 1; let b=c2*(3+x);",
+        "list [1, a , 2];",
+        "let a = ; let b = 2;",
+        "## anything",
+        "###",
+        "let 1",
+        ""
+    };
+
+    for (const char* src : sources) {
+        test_compiled_grammar(program, src);
+        test_compiled_grammar(program, src, true);
+        test_compiled_grammar(stmt, src);
+    }
+
+    const auto compiled_grammar = compile(*p::set(" \n"));
+    assert(compiled_grammar.get_instructions().size() == 2);
+    assert(compiled_grammar.get_instructions()[0].get_opcode() == bytecode_opcode::span_set);
+}
+
+
+static void test_left_factoring() {
+    size_t cond_count = 0;
+
+    p::rule ws, ident, cond, block, stmt, program;
+
+    ws = *p::set(" \n");
+    ident = (+p::range('a', 'z'))->*1;
+    cond = (p::function([&](p::parse_context&) { ++cond_count; return true; }) >> '(' >> ws >> ident >> ws >> ')')->*2;
+    block = ('{' >> *(p::parse_node_ptr(ws) >> stmt) >> ws >> '}')->*3;
+    stmt
+        = (p::terminal("if") >> ws >> cond >> ws >> block >> ws >> "else" >> ws >> block)->*4
+        | (p::terminal("if") >> ws >> cond >> ws >> block)->*5
+        | (p::terminal("while") >> ws >> cond >> ws >> block)->*6
+        | p::terminal("do") >> ws >> block >> ws >> "until" >> ws >> cond
+        | p::terminal("do") >> ws >> block >> ws >> ';';
+    program = *(p::parse_node_ptr(ws) >> stmt) >> ws >> p::end();
+
+    const char* sources[] = {
+        "if (a) { if (b) { if (c) { } } }",
+        "if (a) { } else { while (b) { if (c) {} else {} } } do { } until (d) do { } ;",
+        "if (a) { if (b) { } else",
+        ""
+    };
+
+    std::vector<std::string> source_strings(std::begin(sources), std::end(sources));
+    std::vector<p::parse_context> contexts;
+    std::vector<bool> results;
+    for (const std::string& source : source_strings) {
+        contexts.emplace_back(source);
+        results.push_back(program.parse(contexts.back()));
+    }
+    const size_t total_cond_count = cond_count;
+
+    const optimization_report report = optimize(program);
+    assert(report.get_factored_count() == 4);
+
+    cond_count = 0;
+    for (size_t index = 0; index < source_strings.size(); ++index) {
+        p::parse_context pc(source_strings[index]);
+        const bool ok = program.parse(pc);
+        assert(ok == results[index]);
+        assert(pc.get_iterator() == contexts[index].get_iterator());
+        assert(is_same_match_tree(pc.get_matches(), contexts[index].get_matches()));
+    }
+    assert(cond_count < total_cond_count);
+
+    {
+        p::rule head = p::terminal('a') >> p::cut();
+        p::rule g = (head >> 'b') | (head >> 'c');
+        const std::string src = "ac";
+
+        p::parse_context pc1(src);
+        assert(!g.parse(pc1));
+
+        assert(optimize(g).get_factored_count() == 0);
+
+        p::parse_context pc2(src);
+        assert(!g.parse(pc2));
+    }
+}
+
+
+static void test_static_parser() {
+    using sp = static_parser<>;
+
+    p::rule add, mul, value, d_add, d_mul, d_value;
+
+    const auto digit = sp::range('0', '9');
+    const auto num = (+digit)->*2;
+    const auto ident = (sp::range('a', 'z') >> *(sp::range('a', 'z') | digit))->*1;
+
+    value = num | ident | ('(' >> sp::ref(add) >> ')');
+    mul = (mul >> '*' >> value)->*3 | value;
+    add = (add >> '+' >> mul)->*4 | mul;
+
+    d_value = (+p::range('0', '9'))->*2 | (p::range('a', 'z') >> *(p::range('a', 'z') | p::range('0', '9')))->*1 | ('(' >> d_add >> ')');
+    d_mul = (d_mul >> '*' >> d_value)->*3 | d_value;
+    d_add = (d_add >> '+' >> d_mul)->*4 | d_mul;
+
+    const char* sources[] = { "1+a2*(3+b)*5", "(1", "x*", "" };
+
+    for (const char* src : sources) {
+        std::string source = src;
+        p::parse_context pc1(source);
+        const bool ok1 = add.parse(pc1);
+        p::parse_context pc2(source);
+        const bool ok2 = d_add.parse(pc2);
+        assert(ok1 == ok2);
+        assert(pc1.get_iterator() == pc2.get_iterator());
+        assert(is_same_match_tree(pc1.get_matches(), pc2.get_matches()));
+    }
+
+    freeze(add);
+    assert(!value.is_left_recursive());
+    assert(mul.is_left_recursive());
+
+    {
+        const auto date = (4 * digit >> '-' >> digit * 2 >> -('-' >> 2 * digit))->*5 >> &sp::set(" ;") >> !sp::terminal(";;") >> *sp::any();
+        std::string src = "2024-01-31 ok";
+        p::parse_context pc(src);
+        const bool ok = date.parse(pc);
+        assert(ok);
+        assert(pc.get_iterator() == src.end());
+        assert(pc.get_matches().size() == 1);
+        assert(pc.get_matches()[0].get_source() == "2024-01-31");
+    }
+
+    {
+        const auto line = *(sp::any() - '\n') >> sp::newline('\n');
+        const auto grammar = p::terminal('[') >> *(line | sp::error(1, sp::terminal("x"))) >> ']' >> sp::end();
+        std::string src = "[a\nbc\nx]";
+        p::parse_context pc(src);
+        const bool ok = grammar.parse(pc);
+        assert(ok);
+        assert(pc.get_iterator() == src.end());
+        assert(pc.get_errors().size() == 1);
+    }
+}
+
+
 static void test_ast() {
     enum { GRAMMAR, A, B, C };
 
@@ -1259,7 +2885,9 @@ static void test_ast() {
 void run_tests() {
     test_parse_symbol();
     test_parse_string();
+    test_parse_string_contiguous();
     test_parse_set();
+    test_parse_set_lookup();
     test_parse_range();
     test_parse_loop_0();
     test_parse_loop_1();
@@ -1277,9 +2905,33 @@ void run_tests() {
     test_parse_function();
     test_parse_newline();
     test_parse_match();
+    test_parse_nested_matches();
+    test_matches_outlive_parse_context();
     test_parse_error();
     test_parse_case_insensitive();
+    test_case_folding();
     test_parse_rule();
     test_parse_left_recursion();
+    test_parse_memoization();
+    test_parse_checkpoint();
+    test_freeze();
+    test_freeze_rule_indexes();
+    test_choice_dispatch();
+    test_optimize();
+    test_span();
+    test_until();
+    test_lexemes();
+    test_numeric_values();
+    test_mapped_source();
+    test_stream_source();
+    test_cut();
+    test_segmented_source();
+    test_padded_source();
+    test_skip_prefilter();
+    test_skip_patterns();
+    test_one_of();
+    test_compile();
+    test_left_factoring();
+    test_static_parser();
     test_ast();
 }